@@ -0,0 +1,397 @@
+/*******************************************************************************
+
+  MODULE:                   bgrid_obj.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This module is a pseudo-object which stores bit-packed binary views
+     of the urban grids (the Z grid and the urban control grids) and
+     provides the neighbour, edge and image comparison counts computed
+     on them with shifts and population counts.
+
+  NOTES:
+
+     The packed views are only allocated when PACKED_URBAN_GRID(YES/NO)
+     is set to YES in the scenario file. The Z view is kept in sync with
+     the Z grid by grw_grow and spr_spread.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "globals.h"
+#include "igrid_obj.h"
+#include "scenario_obj.h"
+#include "ugm_macros.h"
+#include "bgrid_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static int nrows;
+static int ncols;
+static int words_per_row;
+static BGRID_WORD last_col_bit;
+static BGRID_WORD *z_bits;
+static BGRID_WORD *urban_bits[MAX_URBAN_YEARS];
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_Init
+** PURPOSE:       allocate the packed grids and pack the urban control grids
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Must be called after the input grids have been read.
+**                Does nothing when the packed urban grid option is off.
+**
+*/
+void
+  bgrid_Init ()
+{
+  char func[] = "bgrid_Init";
+  GRID_P urban_ptr;
+  int bytes_per_grid;
+  int i;
+
+  if (!scen_GetPackedUrbanGridFlag ())
+  {
+    return;
+  }
+
+  nrows = igrid_GetNumRows ();
+  ncols = igrid_GetNumCols ();
+  words_per_row = (ncols + BGRID_BITS - 1) / BGRID_BITS;
+  last_col_bit = ((BGRID_WORD) 1) << ((ncols - 1) % BGRID_BITS);
+  bytes_per_grid = nrows * words_per_row * sizeof (BGRID_WORD);
+
+  z_bits = malloc (bytes_per_grid);
+  if (z_bits == NULL)
+  {
+    sprintf (msg_buf, "Unable to allocate %u bytes of memory (packed Z)",
+             bytes_per_grid);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  memset (z_bits, 0, bytes_per_grid);
+
+  for (i = 0; i < igrid_GetUrbanCount (); i++)
+  {
+    urban_bits[i] = malloc (bytes_per_grid);
+    if (urban_bits[i] == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (packed urban)",
+               bytes_per_grid);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    urban_ptr = igrid_GetUrbanGridPtr (__FILE__, func, __LINE__, i);
+    bgrid_Pack (urban_ptr, urban_bits[i]);
+    urban_ptr = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr);
+  }
+
+  if (scen_GetLogFlag ())
+  {
+    scen_Append2Log ();
+    fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (packed grids)\n",
+             __FILE__, __LINE__, (igrid_GetUrbanCount () + 1) * bytes_per_grid);
+    scen_CloseLog ();
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_MemoryLog
+** PURPOSE:       log memory map to FILE* fp
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  bgrid_MemoryLog (FILE * fp)
+{
+  LOG_MEM (fp, &z_bits, sizeof (BGRID_WORD *), 1);
+  LOG_MEM (fp, &urban_bits[0], sizeof (BGRID_WORD *), MAX_URBAN_YEARS);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_GetWordsPerRow
+** PURPOSE:       return the number of words used by a packed row
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+  bgrid_GetWordsPerRow ()
+{
+  return words_per_row;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_GetZBitsPtr
+** PURPOSE:       return a pointer to the packed Z grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BGRID_WORD *
+  bgrid_GetZBitsPtr ()
+{
+  return z_bits;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_GetUrbanBitsPtr
+** PURPOSE:       return a pointer to the packed urban control grid index
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BGRID_WORD *
+  bgrid_GetUrbanBitsPtr (int index)
+{
+  char func[] = "bgrid_GetUrbanBitsPtr";
+
+  if ((index < 0) || (index >= igrid_GetUrbanCount ()))
+  {
+    sprintf (msg_buf, "index = %d is out of range", index);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  return urban_bits[index];
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_ClearZ
+** PURPOSE:       clear every bit of the packed Z grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  bgrid_ClearZ ()
+{
+  memset (z_bits, 0, nrows * words_per_row * sizeof (BGRID_WORD));
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_SetZ
+** PURPOSE:       mark pixel (row, col) as urban in the packed Z grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  bgrid_SetZ (int row, int col)
+{
+  z_bits[row * words_per_row + col / BGRID_BITS] |=
+    ((BGRID_WORD) 1) << (col % BGRID_BITS);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_CountZNeighbors
+** PURPOSE:       count the urban neighbors of an interior pixel
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Same result as util_count_neighbors (z, row, col, GT, 0).
+**                The three bits of columns col-1..col+1 are extracted from
+**                each of the three rows and the eight neighbors are counted
+**                with population counts.
+**
+*/
+int
+  bgrid_CountZNeighbors (int row, int col)
+{
+  BGRID_WORD *row_ptr;
+  BGRID_WORD up;
+  BGRID_WORD mid;
+  BGRID_WORD down;
+  int word;
+  int shift;
+
+  word = (col - 1) / BGRID_BITS;
+  shift = (col - 1) % BGRID_BITS;
+  row_ptr = z_bits + (row - 1) * words_per_row + word;
+
+  up = row_ptr[0] >> shift;
+  mid = row_ptr[words_per_row] >> shift;
+  down = row_ptr[2 * words_per_row] >> shift;
+  if (shift > BGRID_BITS - 3)
+  {
+    up |= row_ptr[1] << (BGRID_BITS - shift);
+    mid |= row_ptr[words_per_row + 1] << (BGRID_BITS - shift);
+    down |= row_ptr[2 * words_per_row + 1] << (BGRID_BITS - shift);
+  }
+
+  return BGRID_POPCOUNT (up & 7) + BGRID_POPCOUNT (mid & 5) +
+    BGRID_POPCOUNT (down & 7);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_Pack
+** PURPOSE:       pack a grid into its binary (pixel > 0) view
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  bgrid_Pack (GRID_P grid, BGRID_WORD * bits)
+{
+  BGRID_WORD word;
+  int row;
+  int col;
+  int w;
+  int bit;
+
+  for (row = 0; row < nrows; row++)
+  {
+    for (w = 0; w < words_per_row; w++)
+    {
+      word = 0;
+      for (bit = 0; bit < BGRID_BITS; bit++)
+      {
+        col = w * BGRID_BITS + bit;
+        if (col >= ncols)
+        {
+          break;
+        }
+        if (grid[row * ncols + col] > 0)
+        {
+          word |= ((BGRID_WORD) 1) << bit;
+        }
+      }
+      bits[row * words_per_row + w] = word;
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_CountEdges
+** PURPOSE:       count the set pixels and the edge pixels of a packed grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Same result as the 4 neighbor (N, S, E, W) search of
+**                stats_edge: a set pixel is an edge if one of its neighbors
+**                inside the image is not set. Neighbors outside the image
+**                are taken as set.
+**
+*/
+void
+  bgrid_CountEdges (BGRID_WORD * bits, int *area, int *edges)
+{
+  BGRID_WORD *cur;
+  BGRID_WORD c;
+  BGRID_WORD north;
+  BGRID_WORD south;
+  BGRID_WORD west;
+  BGRID_WORD east;
+  int row;
+  int w;
+
+  *area = 0;
+  *edges = 0;
+  for (row = 0; row < nrows; row++)
+  {
+    cur = bits + row * words_per_row;
+    for (w = 0; w < words_per_row; w++)
+    {
+      c = cur[w];
+      if (c == 0)
+      {
+        continue;
+      }
+      north = (row > 0) ? cur[w - words_per_row] : ~((BGRID_WORD) 0);
+      south = (row < nrows - 1) ? cur[w + words_per_row] : ~((BGRID_WORD) 0);
+      west = (c << 1) | ((w > 0) ? cur[w - 1] >> (BGRID_BITS - 1) : 1);
+      if (w < words_per_row - 1)
+      {
+        east = (c >> 1) | (cur[w + 1] << (BGRID_BITS - 1));
+      }
+      else
+      {
+        east = (c >> 1) | last_col_bit;
+      }
+      *area += BGRID_POPCOUNT (c);
+      *edges += BGRID_POPCOUNT (c & ~(north & south & west & east));
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: bgrid_CountIntersectionUnion
+** PURPOSE:       count the pixels set in both and in either packed grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  bgrid_CountIntersectionUnion (BGRID_WORD * bits1,
+                                BGRID_WORD * bits2,
+                                int *intersection,
+                                int *the_union)
+{
+  int total_words;
+  int i;
+
+  total_words = nrows * words_per_row;
+  *intersection = 0;
+  *the_union = 0;
+  for (i = 0; i < total_words; i++)
+  {
+    *intersection += BGRID_POPCOUNT (bits1[i] & bits2[i]);
+    *the_union += BGRID_POPCOUNT (bits1[i] | bits2[i]);
+  }
+}
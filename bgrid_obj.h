@@ -0,0 +1,38 @@
+#ifndef BGRID_OBJ_H
+#define BGRID_OBJ_H
+#include <stdio.h>
+#include "ugm_defines.h"
+
+/*
+ *
+ * A bgrid is a bit-packed binary view of a grid: one bit per pixel
+ * (set when the pixel is > 0), BGRID_BITS pixels per word, each row
+ * starting on a new word. Column j of a row is bit (j % BGRID_BITS)
+ * of word (j / BGRID_BITS). Bits past the last column are kept at 0.
+ *
+ */
+#define BGRID_WORD unsigned long long
+#define BGRID_BITS 64
+
+#ifdef _MSC_VER
+  #include <intrin.h>
+  #define BGRID_POPCOUNT(w) ((int)__popcnt64 (w))
+#else
+  #define BGRID_POPCOUNT(w) (__builtin_popcountll (w))
+#endif
+
+void bgrid_Init ();
+void bgrid_MemoryLog (FILE * fp);
+int bgrid_GetWordsPerRow ();
+BGRID_WORD *bgrid_GetZBitsPtr ();
+BGRID_WORD *bgrid_GetUrbanBitsPtr (int index);
+void bgrid_ClearZ ();
+void bgrid_SetZ (int row, int col);
+int bgrid_CountZNeighbors (int row, int col);
+void bgrid_Pack (GRID_P grid, BGRID_WORD * bits);
+void bgrid_CountEdges (BGRID_WORD * bits, int *area, int *edges);
+void bgrid_CountIntersectionUnion (BGRID_WORD * bits1,
+                                   BGRID_WORD * bits2,
+                                   int *intersection,
+                                   int *the_union);
+#endif
@@ -0,0 +1,345 @@
+/*******************************************************************************
+
+  MODULE:                   cgrid_obj.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This module is a pseudo-object which stores the per year Monte Carlo
+     cumulate grids of the urban area and of the roads, so that every
+     iteration adds into them directly instead of reading the grid back
+     from a file and dumping it again. It also stores the count of the
+     iterations which end with each pixel urban. The grids hold
+     ACCUM_TYPE counts, which are only scaled to 8 bit probabilities by
+     the last iteration.
+
+  NOTES:
+
+     The grids are allocated as one block. When the block is larger than
+     the memory budget (CUMULATE_MEMORY_MB, default CGRID_DEFAULT_MEMORY_MB)
+     it is backed by a memory-mapped scratch file of the output directory,
+     which is removed when the program exits.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _MSC_VER
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+#include "globals.h"
+#include "memory_obj.h"
+#include "scenario_obj.h"
+#include "ugm_macros.h"
+#include "cgrid_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static char *cumulate_block;
+static size_t block_bytes;
+static size_t bytes_per_grid;
+static int first_year;
+static int num_years;
+static BOOLEAN mapped;
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                        STATIC FUNCTION PROTOTYPES                         **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static void cgrid_map_file (char *filename);
+static ACCUM_P cgrid_get_ptr (int index);
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_Init
+** PURPOSE:       allocate the cumulate grids of years first..last
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Called at the start of every Monte Carlo iteration; the
+**                block is only allocated the first time. The grids are
+**                not cleared here: the first iteration of a run clears
+**                the grids of each year before adding into them.
+**
+*/
+void
+  cgrid_Init (int first, int last)
+{
+  char func[] = "cgrid_Init";
+  char filename[MAX_FILENAME_LEN];
+  size_t budget;
+  int budget_mb;
+
+  if (cumulate_block != NULL)
+  {
+    if ((first == first_year) && (last - first + 1 == num_years))
+    {
+      return;
+    }
+    sprintf (msg_buf, "cumulate years %d..%d differ from %d..%d",
+             first, last, first_year, first_year + num_years - 1);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  first_year = first;
+  num_years = last - first + 1;
+  if (num_years < 1)
+  {
+    num_years = 1;
+  }
+  bytes_per_grid = (size_t) mem_GetTotalPixels () * sizeof (ACCUM_TYPE);
+  bytes_per_grid = (bytes_per_grid + 7) & ~((size_t) 7);
+  block_bytes = (2 * (size_t) num_years + 1) * bytes_per_grid;
+
+  budget_mb = scen_GetCumulateMemoryMB ();
+  if (budget_mb <= 0)
+  {
+    budget_mb = CGRID_DEFAULT_MEMORY_MB;
+  }
+  budget = (size_t) budget_mb * 1024 * 1024;
+
+  mapped = (block_bytes > budget);
+  if (mapped)
+  {
+    sprintf (filename, "%scumulate_grids.tmp", scen_GetOutputDir ());
+    cgrid_map_file (filename);
+  }
+  else
+  {
+    cumulate_block = malloc (block_bytes);
+    if (cumulate_block == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %llu bytes of memory (cumulate)",
+               (unsigned long long) block_bytes);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+  }
+
+  if (scen_GetLogFlag ())
+  {
+    scen_Append2Log ();
+    fprintf (scen_GetLogFP (),
+             "%s %u %s %llu bytes for the cumulate grids of %d years\n",
+             __FILE__, __LINE__,
+             mapped ? "Mapped" : "Allocated",
+             (unsigned long long) block_bytes, num_years);
+    scen_CloseLog ();
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_MemoryLog
+** PURPOSE:       log memory map to FILE* fp
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  cgrid_MemoryLog (FILE * fp)
+{
+  LOG_MEM (fp, &cumulate_block, sizeof (char *), 1);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_GetUrbanPtr
+** PURPOSE:       return the urban cumulate grid of year
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+ACCUM_P
+  cgrid_GetUrbanPtr (int year)
+{
+  char func[] = "cgrid_GetUrbanPtr";
+
+  if ((year < first_year) || (year >= first_year + num_years))
+  {
+    sprintf (msg_buf, "no cumulate grid for year %d", year);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  return cgrid_get_ptr (2 * (year - first_year));
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_GetRoadPtr
+** PURPOSE:       return the road cumulate grid of year
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+ACCUM_P
+  cgrid_GetRoadPtr (int year)
+{
+  char func[] = "cgrid_GetRoadPtr";
+
+  if ((year < first_year) || (year >= first_year + num_years))
+  {
+    sprintf (msg_buf, "no cumulate grid for year %d", year);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  return cgrid_get_ptr (2 * (year - first_year) + 1);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_GetMonteCarloPtr
+** PURPOSE:       return the count of iterations ending with each pixel urban
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+ACCUM_P
+  cgrid_GetMonteCarloPtr ()
+{
+  return cgrid_get_ptr (2 * num_years);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_get_ptr
+** PURPOSE:       return grid index of the block
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static ACCUM_P
+  cgrid_get_ptr (int index)
+{
+  char func[] = "cgrid_get_ptr";
+
+  if (cumulate_block == NULL)
+  {
+    sprintf (msg_buf, "cumulate grids are not allocated");
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  return (ACCUM_P) (cumulate_block + (size_t) index * bytes_per_grid);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: cgrid_map_file
+** PURPOSE:       back the cumulate block with a memory-mapped file
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The file is unlinked (deleted on close under Windows) as
+**                soon as it is mapped, so it never outlives the program.
+**
+*/
+static void
+  cgrid_map_file (char *filename)
+{
+  char func[] = "cgrid_map_file";
+#ifdef _MSC_VER
+  HANDLE file;
+  HANDLE mapping;
+
+  file = CreateFileA (filename, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                      CREATE_ALWAYS,
+                      FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+                      NULL);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    sprintf (msg_buf, "Unable to create %s", filename);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  mapping = CreateFileMappingA (file, NULL, PAGE_READWRITE,
+                                (DWORD) ((unsigned long long) block_bytes >> 32),
+                                (DWORD) (block_bytes & 0xFFFFFFFF), NULL);
+  if (mapping == NULL)
+  {
+    sprintf (msg_buf, "Unable to map %llu bytes of %s",
+             (unsigned long long) block_bytes, filename);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  cumulate_block = MapViewOfFile (mapping, FILE_MAP_ALL_ACCESS, 0, 0,
+                                  block_bytes);
+  if (cumulate_block == NULL)
+  {
+    sprintf (msg_buf, "Unable to map %llu bytes of %s",
+             (unsigned long long) block_bytes, filename);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+#else
+  int fd;
+  void *block;
+
+  fd = open (filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0)
+  {
+    sprintf (msg_buf, "Unable to create %s", filename);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  if (ftruncate (fd, (off_t) block_bytes) != 0)
+  {
+    sprintf (msg_buf, "Unable to extend %s to %llu bytes",
+             filename, (unsigned long long) block_bytes);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  block = mmap (NULL, block_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (block == MAP_FAILED)
+  {
+    sprintf (msg_buf, "Unable to map %llu bytes of %s",
+             (unsigned long long) block_bytes, filename);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  close (fd);
+  unlink (filename);
+  cumulate_block = block;
+#endif
+}
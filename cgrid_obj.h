@@ -0,0 +1,21 @@
+#ifndef CGRID_OBJ_H
+#define CGRID_OBJ_H
+#include <stdio.h>
+#include "ugm_defines.h"
+
+/*
+ *
+ * A cgrid holds the Monte Carlo cumulate grids (urban and roads) of every
+ * simulated year, plus the urban count of the final year used by
+ * drv_monte_carlo, as ACCUM_TYPE counts. They live in memory when they
+ * fit in the budget set by
+ * CUMULATE_MEMORY_MB (CGRID_DEFAULT_MEMORY_MB when unset), and in a
+ * single memory-mapped scratch file of the output directory otherwise.
+ *
+ */
+void cgrid_Init (int first, int last);
+void cgrid_MemoryLog (FILE * fp);
+ACCUM_P cgrid_GetUrbanPtr (int year);
+ACCUM_P cgrid_GetRoadPtr (int year);
+ACCUM_P cgrid_GetMonteCarloPtr ();
+#endif
@@ -17,6 +17,7 @@ The coeff_obj.c module encapsulates the parameter data structures
 #include "proc_obj.h"
 #include "memory_obj.h"
 #include "globals.h"
+#include "rstore_obj.h"
 
 char coeff_obj_c_sccs_id[] = "@(#)coeff_obj.c	1.84	12/4/00";
 
@@ -34,6 +35,10 @@ static coeff_int_info start_coeff;
 static coeff_int_info stop_coeff;
 static coeff_int_info best_fit_coeff;
 static char coeff_filename[MAX_FILENAME_LEN];
+static char *coeff_names[] = {
+  "Run", "MC", "Year", "Diffusion", "Breed", "Spread", "SlopeResist",
+  "RoadGrav"
+};
 
 /*****************************************************************************\
 *******************************************************************************
@@ -1440,16 +1445,36 @@ void
 ** DESCRIPTION:   the coefficient file is initially created by
 **                coeff_CreateCoeffFile () which initializes
 **                the coeff_filename variable.
-**
+**                with WRITE_RESULTS_STORE the coefficients are a row of
+**                the coeff results table instead (agent 10/19/2026).
 **
 */
 void
   coeff_WriteCurrentCoeff ()
 {
   char func[] = "coeff_WriteCurrentCoeff";
+  static int table = -1;
+  int ints[3];
+  double reals[5];
   FILE *fp;
 
-  if (scen_GetWriteCoeffFileFlag ())
+  if (scen_GetWriteCoeffFileFlag () && scen_GetWriteResultsStoreFlag ())
+  {
+    if (table < 0)
+    {
+      table = rstore_DefineTable ("coeff", 8, coeff_names, 3);
+    }
+    ints[0] = proc_GetCurrentRun ();
+    ints[1] = proc_GetCurrentMonteCarlo ();
+    ints[2] = proc_GetCurrentYear ();
+    reals[0] = current_coefficient.diffusion;
+    reals[1] = current_coefficient.breed;
+    reals[2] = current_coefficient.spread;
+    reals[3] = current_coefficient.slope_resistance;
+    reals[4] = current_coefficient.road_gravity;
+    rstore_AppendRow (table, ints, reals);
+  }
+  else if (scen_GetWriteCoeffFileFlag ())
   {
     FILE_OPEN (fp, coeff_filename, "a");
 
@@ -1482,7 +1507,7 @@ void
 {
   char func[] = "coeff_CreateCoeffFile";
   FILE *fp;
-  if (scen_GetWriteCoeffFileFlag ())
+  if (scen_GetWriteCoeffFileFlag () && !scen_GetWriteResultsStoreFlag ())
   {
 #if 1
     sprintf (coeff_filename, "%scoeff_run%u",
@@ -27,15 +27,43 @@
 \*****************************************************************************/
 #define TRANS_PROBABILITY1(arg1,arg2)                  \
     ftransition[TRANS_OFFSET(                          \
-       new_indices[urban_land[OFFSET((arg1),(arg2))]], \
+       new_indices[GV_PIXEL(urban_land,(arg1),(arg2))],  \
        new_indices[new_landuse])]
 
 #define TRANS_PROBABILITY2(arg1,arg2,arg3,arg4)                    \
    ftransition[TRANS_OFFSET(                                       \
-     new_indices[phase2_land[OFFSET((arg1),(arg2))]],              \
-     new_indices[urban_land[OFFSET((arg3),(arg4))]])]*             \
+     new_indices[GV_PIXEL(phase2_land,(arg1),(arg2))],             \
+     new_indices[GV_PIXEL(urban_land,(arg3),(arg4))])]*            \
      DELTA_PHASE2_SENSITIVITY
 
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+/* Deltatron active set (SPARSE_DELTATRON): offsets of the live deltatrons */
+static BOOLEAN sparse;
+static int *active;
+static int active_count;
+static int *candidates;
+static PIXEL *candidate_flag;
+/* Transition index (INDEXED_DELTATRON_CENTERS): transitional pixels of the
+ * land grid, kept up to date wherever the land grid changes */
+static BOOLEAN indexed;
+static BOOLEAN index_valid;
+static int *trans_index;
+static int *trans_pos;
+static int trans_count;
+/* Land changes: births of the current call, and pixels of the land grids
+ * changed since they were initialized from land use grid land_source */
+static int *birth_log;
+static int birth_count;
+static int *changed;
+static int changed_count;
+static PIXEL *changed_flag;
+static int land_source = -1;
 
 /*****************************************************************************\
 *******************************************************************************
@@ -44,12 +72,32 @@
 **                                                                           **
 *******************************************************************************
 \*****************************************************************************/
+static
+  BOOLEAN delta_any_transitional (grid_view * urban_land,    /* IN     */
+                                  Classes * landuse_classes, /* IN     */
+                                  int *new_indices);       /* IN     */
+static
+  void delta_index_build (grid_view * urban_land,            /* IN     */
+                          Classes * landuse_classes,         /* IN     */
+                          int *new_indices);               /* IN     */
+static
+  void delta_land_set (int offset,                           /* IN     */
+                       PIXEL value,                          /* IN     */
+                       GRID_P land1,                         /* IN/OUT */
+                       GRID_P land2,                         /* IN/OUT */
+                       Classes * landuse_classes,            /* IN     */
+                       int *new_indices);                  /* IN     */
+static
+  void delta_index_update (int offset,                       /* IN     */
+                           GRID_P land,                      /* IN     */
+                           Classes * landuse_classes,        /* IN     */
+                           int *new_indices);              /* IN     */
 static
   void delta_phase1 (int drive,                              /* IN     */
-                     GRID_P urban_land,                      /* IN     */
-                     GRID_P phase1_land,                     /* OUT    */
-                     GRID_P slope,                           /* IN     */
-                     GRID_P deltatron,                       /* IN/OUT */
+                     grid_view * urban_land,                 /* IN     */
+                     grid_view * phase1_land,                /* OUT    */
+                     grid_view * slope,                      /* IN     */
+                     grid_view * deltatron,                  /* IN/OUT */
                      Classes * landuse_classes,              /* IN     */
                      Classes * class_indices,                /* IN     */
                      int *new_indices,                       /* IN     */
@@ -61,13 +109,29 @@ static
                              PIXEL local_slope,              /* IN     */
                              CLASS_SLP_TYPE * class_slope); /* IN     */
 static
-  void delta_phase2 (GRID_P urban_land,                      /* IN     */
-                     GRID_P phase1_land,                     /* IN     */
-                     GRID_P deltatron,                       /* IN/OUT */
-                     GRID_P phase2_land,                     /* OUT    */
+  void delta_phase2 (grid_view * urban_land,                 /* IN     */
+                     grid_view * phase1_land,                /* IN     */
+                     grid_view * deltatron,                  /* IN/OUT */
+                     grid_view * phase2_land,                /* OUT    */
                      Classes * landuse_classes,              /* IN     */
                      int *new_indices,                       /* IN     */
                      FTRANS_TYPE * ftransition);           /* IN     */
+static
+  void delta_phase2_pixel (int i,                            /* IN     */
+                           int j,                            /* IN     */
+                           grid_view * urban_land,           /* IN     */
+                           grid_view * phase1_land,          /* IN     */
+                           grid_view * deltatron,            /* IN/OUT */
+                           grid_view * phase2_land,          /* OUT    */
+                           Classes * landuse_classes,        /* IN     */
+                           int *new_indices,                 /* IN     */
+                           FTRANS_TYPE * ftransition);     /* IN     */
+static
+  void delta_birth (grid_view * deltatron,                   /* IN/OUT */
+                    int i,                                   /* IN     */
+                    int j);                                /* IN     */
+static
+  void delta_age (grid_view * deltatron);                  /* IN/OUT */
 
 /*****************************************************************************\
 *******************************************************************************
@@ -85,26 +149,35 @@ char deltatron_c_sccs_id[] = "@(#)deltatron.c	1.372	12/4/00";
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
+** DESCRIPTION:   land_out must equal urban_land on entry (see
+**                delta_InitLand and delta_ConditionUrban). Both phases
+**                transition land_out in place, then only the pixels born
+**                are copied back into urban_land, so the grids are equal
+**                again on return.
 **
+**                Phase 2 may work in place on the phase 1 grid: a pixel
+**                it transitions gets a deltatron of 1, and the land of a
+**                pixel is only used while its deltatron is 0 or 2.
 **
 */
 void
   delta_deltatron (int *new_indices,                         /* IN     */
                    Classes * landuse_classes,                /* IN     */
                    Classes * class_indices,                  /* IN     */
-                   GRID_P workspace1,                        /* MOD    */
                    GRID_P deltatron,                         /* IN/OUT */
-                   GRID_P urban_land,                        /* IN     */
-                   GRID_P land_out,                          /* OUT    */
+                   GRID_P urban_land,                        /* IN/OUT */
+                   GRID_P land_out,                          /* IN/OUT */
                    GRID_P slp,                               /* IN     */
                    int drive,                                /* IN     */
                    CLASS_SLP_TYPE * class_slope,             /* IN     */
                    FTRANS_TYPE * ftransition)              /* IN     */
 {
   char func[] = "DeltaTron";
-  GRID_P phase1_land;
-  GRID_P phase2_land;
+  grid_view urban_view;
+  grid_view land_view;
+  grid_view slope_view;
+  grid_view deltatron_view;
+  int k;
 
 
   timer_Start (DELTA_DELTATRON);
@@ -112,21 +185,22 @@ void
   assert (new_indices != NULL);
   assert (landuse_classes != NULL);
   assert (class_indices != NULL);
-  assert (workspace1 != NULL);
   assert (urban_land != NULL);
   assert (land_out != NULL);
   assert (slp != NULL);
   assert (class_slope != NULL);
   assert (ftransition != NULL);
 
-  phase1_land = workspace1;
-  phase2_land = land_out;
+  grid_SetView (&urban_view, urban_land);
+  grid_SetView (&land_view, land_out);
+  grid_SetView (&slope_view, slp);
+  grid_SetView (&deltatron_view, deltatron);
 
   delta_phase1 (drive,                                       /* IN     */
-                urban_land,                                  /* IN     */
-                phase1_land,                                 /* OUT    */
-                slp,                                         /* IN     */
-                deltatron,                                   /* IN/OUT */
+                &urban_view,                                 /* IN     */
+                &land_view,                                  /* OUT    */
+                &slope_view,                                 /* IN     */
+                &deltatron_view,                             /* IN/OUT */
                 landuse_classes,                             /* IN     */
                 class_indices,                               /* IN     */
                 new_indices,                                 /* IN     */
@@ -134,15 +208,27 @@ void
                 ftransition                                  /* IN     */
     );
 
-  delta_phase2 (urban_land,                                  /* IN     */
-                phase1_land,                                 /* IN     */
-                deltatron,                                   /* IN/OUT */
-                phase2_land,                                 /* OUT    */
+  delta_phase2 (&urban_view,                                 /* IN     */
+                &land_view,                                  /* IN     */
+                &deltatron_view,                             /* IN/OUT */
+                &land_view,                                  /* OUT    */
                 landuse_classes,                             /* IN     */
                 new_indices,                                 /* IN     */
                 ftransition                                  /* IN     */
     );
 
+  /*
+   *
+   * COPY THE TRANSITIONED PIXELS BACK INTO THE INPUT LAND GRID
+   *
+   */
+  for (k = 0; k < birth_count; k++)
+  {
+    delta_land_set (birth_log[k], land_out[birth_log[k]],
+                    urban_land, land_out, landuse_classes, new_indices);
+  }
+  birth_count = 0;
+
   timer_Stop (DELTA_DELTATRON);
   FUNC_END;
 }
@@ -154,7 +240,7 @@ void
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
+** DESCRIPTION:   phase1_land equals urban_land on entry.
 **
 **
 */
@@ -162,10 +248,10 @@ void
 static
   void
   delta_phase1 (int drive,                                   /* IN     */
-                GRID_P urban_land,                           /* IN     */
-                GRID_P phase1_land,                          /* OUT    */
-                GRID_P slope,                                /* IN     */
-                GRID_P deltatron,                            /* IN/OUT */
+                grid_view * urban_land,                      /* IN     */
+                grid_view * phase1_land,                     /* OUT    */
+                grid_view * slope,                           /* IN     */
+                grid_view * deltatron,                       /* IN/OUT */
                 Classes * landuse_classes,                   /* IN     */
                 Classes * class_indices,                     /* IN     */
                 int *new_indices,                            /* IN     */
@@ -180,6 +266,7 @@ static
   int l;
   int i_center;
   int j_center;
+  int offset;
   PIXEL new_landuse;
   int random_int;
 
@@ -198,10 +285,25 @@ static
 
   /*
    *
-   * COPY INPUT LAND GRID INTO OUTPUT LAND GRID
+   * WITHOUT A TRANSITIONAL PIXEL NO CENTER CAN BE FOUND
    *
    */
-  util_copy_grid (urban_land, phase1_land);
+  if (indexed)
+  {
+    if (!index_valid)
+    {
+      delta_index_build (urban_land, landuse_classes, new_indices);
+    }
+    if (trans_count == 0)
+    {
+      drive = 0;
+    }
+  }
+  else if (!delta_any_transitional (urban_land, landuse_classes,
+                                     new_indices))
+  {
+    drive = 0;
+  }
 
   /*
    *
@@ -215,13 +317,22 @@ static
      * SELECT A TRANSITION PIXEL TO BE CENTER OF SPREADING CLUSTER
      *
      */
-    do
+    if (indexed)
     {
-      i_center = RANDOM_ROW;
-      j_center = RANDOM_COL;
-      index = new_indices[urban_land[OFFSET (i_center, j_center)]];
+      offset = trans_index[RANDOM_INT (trans_count)];
+      i_center = offset / urban_land->stride;
+      j_center = offset % urban_land->stride;
+    }
+    else
+    {
+      do
+      {
+        i_center = RANDOM_INT (urban_land->nrows);
+        j_center = RANDOM_INT (urban_land->ncols);
+        index = new_indices[GV_PIXEL (urban_land, i_center, j_center)];
+      }
+      while (landuse_classes[index].trans == FALSE);
     }
-    while (landuse_classes[index].trans == FALSE);
     /*
      *
      * RANDOMLY CHOOSE NEW LANDUSE NUMBER
@@ -230,7 +341,7 @@ static
     new_landuse =
       delta_get_new_landuse (class_indices,                  /* IN    */
                              landuse_classes,                /* IN    */
-                             slope[OFFSET (i_center, j_center)],   /* IN    */
+                             GV_PIXEL (slope, i_center, j_center), /* IN    */
                              class_slope);                 /* IN    */
 
     /*
@@ -245,8 +356,8 @@ static
        * TRANSITION THE CENTER PIXEL
        *
        */
-      phase1_land[OFFSET (i_center, j_center)] = new_landuse;
-      deltatron[OFFSET (i_center, j_center)] = 1;
+      GV_PIXEL (phase1_land, i_center, j_center) = new_landuse;
+      delta_birth (deltatron, i_center, j_center);
 
       /*
        *
@@ -275,7 +386,7 @@ static
          *
          */
         util_get_neighbor (i, j, &i, &j);
-        if (IMAGE_PT (i, j))
+        if (GV_IMAGE_PT (urban_land, i, j))
         {
           /*
            *
@@ -290,11 +401,11 @@ static
              * CHANGE IT
              *
              */
-            index = new_indices[urban_land[OFFSET (i, j)]];
+            index = new_indices[GV_PIXEL (urban_land, i, j)];
             if (landuse_classes[index].trans == TRUE)
             {
-              phase1_land[OFFSET (i, j)] = new_landuse;
-              deltatron[OFFSET (i, j)] = 1;
+              GV_PIXEL (phase1_land, i, j) = new_landuse;
+              delta_birth (deltatron, i, j);
             }
             /*
              *
@@ -302,13 +413,13 @@ static
              *
              */
             util_get_neighbor (i, j, &i, &j);
-            if (IMAGE_PT (i, j))
+            if (GV_IMAGE_PT (urban_land, i, j))
             {
-              index = new_indices[urban_land[OFFSET (i, j)]];
+              index = new_indices[GV_PIXEL (urban_land, i, j)];
               if (landuse_classes[index].trans == TRUE)
               {
-                phase1_land[OFFSET (i, j)] = new_landuse;
-                deltatron[OFFSET (i, j)] = 1;
+                GV_PIXEL (phase1_land, i, j) = new_landuse;
+                delta_birth (deltatron, i, j);
               }
             }
           }
@@ -400,16 +511,16 @@ static
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
+** DESCRIPTION:   phase1_land and phase2_land may be the same grid.
 **
 **
 */
 static
   void
-  delta_phase2 (GRID_P urban_land,                           /* IN     */
-                GRID_P phase1_land,                          /* IN     */
-                GRID_P deltatron,                            /* IN/OUT */
-                GRID_P phase2_land,                          /* OUT    */
+  delta_phase2 (grid_view * urban_land,                      /* IN     */
+                grid_view * phase1_land,                     /* IN     */
+                grid_view * deltatron,                       /* IN/OUT */
+                grid_view * phase2_land,                     /* OUT    */
                 Classes * landuse_classes,                   /* IN     */
                 int *new_indices,                            /* IN     */
                 FTRANS_TYPE * ftransition)                 /* IN     */
@@ -420,12 +531,10 @@ static
   int i;
   int j;
   int k;
-  int i_nghbr;
-  int j_nghbr;
-  int index;
-  int deltatron_neighbors;
-  int random_int;
-  int max_num_tries = 16;
+  int di;
+  int dj;
+  int offset;
+  int num_candidates;
 
   timer_Start (DELTA_PHASE2);
   FUNC_INIT;
@@ -437,118 +546,528 @@ static
   assert (new_indices != NULL);
   assert (ftransition != NULL);
 
-  /*
-   *
-   * SAVE CURRENT LAND TO PHASE2_LAND
-   *
-   */
-  util_copy_grid (phase1_land, phase2_land);
-
-  /*
-   *
-   * FOR EACH INTERIOR POINT
-   *
-   */
-  for (i = 1; i < igrid_GetNumRows () - 1; i++)
+  if (sparse)
   {
-    for (j = 1; j < igrid_GetNumCols () - 1; j++)
+    /*
+     *
+     * ONLY A PIXEL NEXT TO A DELTATRON OF AGE 2 CAN TRANSITION, SO
+     * THE CANDIDATES ARE THE INTERIOR NEIGHBORS OF THOSE DELTATRONS
+     *
+     */
+    num_candidates = 0;
+    for (k = 0; k < active_count; k++)
     {
-      index = new_indices[phase1_land[OFFSET (i, j)]];
-      if ((landuse_classes[index].trans == TRUE) &&
-          (deltatron[OFFSET (i, j)] == 0))
+      if (deltatron->ptr[active[k]] != 2)
       {
-        /*
-         *
-         * I,J IS A TRANSITIONAL PIXEL WHICH HAS NOT TRANSITIONED
-         * WITHIN THE LAST MIN_YEARS_BETWEEN_TRANSTIONS YEARS; COUNT
-         * ITS NEIGHBORS WHICH HAVE TRANSITIONED IN THE PREVIOUS
-         * YEAR (IE. DELTATRON == 2)
-         *
-         */
-        deltatron_neighbors = util_count_neighbors (deltatron, i, j, EQ, 2);
-
-        random_int = 1 + RANDOM_INT (2);
-        if (deltatron_neighbors >= random_int)
+        continue;
+      }
+      i = active[k] / deltatron->stride;
+      j = active[k] % deltatron->stride;
+      for (di = -1; di <= 1; di++)
+      {
+        for (dj = -1; dj <= 1; dj++)
         {
-          for (k = 0; k < max_num_tries; k++)
+          if ((i + di < 1) || (i + di >= urban_land->nrows - 1) ||
+              (j + dj < 1) || (j + dj >= urban_land->ncols - 1))
           {
-            util_get_neighbor (i, j, &i_nghbr, &j_nghbr);
-            index = new_indices[phase1_land[OFFSET (i_nghbr, j_nghbr)]];
-            if ((deltatron[OFFSET (i_nghbr, j_nghbr)] == 2) &&
-                (landuse_classes[index].trans == TRUE))
-            {
-              if (RANDOM_FLOAT < TRANS_PROBABILITY2 (i, j, i_nghbr, j_nghbr))
-              {
-                phase2_land[OFFSET (i, j)] =
-                  urban_land[OFFSET (i_nghbr, j_nghbr)];
-                deltatron[OFFSET (i, j)] = 1;
-              }
-              /*
-               *
-               * BREAK OUT OF FOR LOOP
-               *
-               */
-              break;
-            }
-            /* end of if( deltatron[OFFSET(i_nghbr,j_nghbr)] == 2) && */
+            continue;
+          }
+          offset = GV_OFFSET (deltatron, i + di, j + dj);
+          if (!candidate_flag[offset])
+          {
+            candidate_flag[offset] = 1;
+            candidates[num_candidates++] = offset;
           }
-          /* end of for(k=0;k<max_num_tries;k++) */
         }
-        /* end of if (deltatron_neighbors >= random_int) */
       }
-      /* end of if(( landuse_classes[index].trans == TRUE ) && */
     }
-    /* end of for (j = 1; j < igrid_GetNumCols() - 1; j++) */
+    for (k = 0; k < num_candidates; k++)
+    {
+      delta_phase2_pixel (candidates[k] / deltatron->stride,
+                          candidates[k] % deltatron->stride,
+                          urban_land, phase1_land, deltatron, phase2_land,
+                          landuse_classes, new_indices, ftransition);
+      candidate_flag[candidates[k]] = 0;
+    }
+  }
+  else
+  {
+    /*
+     *
+     * FOR EACH INTERIOR POINT
+     *
+     */
+    for (i = 1; i < urban_land->nrows - 1; i++)
+    {
+      for (j = 1; j < urban_land->ncols - 1; j++)
+      {
+        delta_phase2_pixel (i, j,
+                            urban_land, phase1_land, deltatron, phase2_land,
+                            landuse_classes, new_indices, ftransition);
+      }
+    }
   }
-  /* end of for (i = 1; i < igrid_GetNumRows() - 1; i++) */
 
   if (scen_GetViewDeltatronAgingFlag ())
   {
     sprintf (gif_filename, "%sdeltatron_%u_%u_%u.gif",
              scen_GetOutputDir (), proc_GetCurrentRun (), proc_GetCurrentMonteCarlo (), proc_GetCurrentYear ());
     sprintf (date_str, "%u", proc_GetCurrentYear ());
-    gdif_WriteGIF (deltatron,
+    gdif_WriteGIF (deltatron->ptr,
                    color_GetColortable (DELTATRON_COLORTABLE),
                    gif_filename,
                    date_str,
                    255);
   }
 
-  /*
-   *
-   * AGE THE DELTATRONS
-   *
-   */
-  for (i = 0; i < mem_GetTotalPixels (); i++)
+  delta_age (deltatron);
+  FUNC_END;
+  timer_Stop (DELTA_PHASE2);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_phase2_pixel
+** PURPOSE:       performs phase 2 deltatron growth at pixel i,j
+** AUTHOR:        Keith Clarke
+** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
+** CREATION DATE: 11/11/1999
+** DESCRIPTION:   body of the delta_phase2 pixel loop, split out by
+**                agent (10/19/2026) so that it also serves the
+**                candidates of the sparse deltatron.
+**
+*/
+static
+  void
+  delta_phase2_pixel (int i,                                 /* IN     */
+                      int j,                                 /* IN     */
+                      grid_view * urban_land,                /* IN     */
+                      grid_view * phase1_land,               /* IN     */
+                      grid_view * deltatron,                 /* IN/OUT */
+                      grid_view * phase2_land,               /* OUT    */
+                      Classes * landuse_classes,             /* IN     */
+                      int *new_indices,                      /* IN     */
+                      FTRANS_TYPE * ftransition)           /* IN     */
+{
+  int k;
+  int i_nghbr;
+  int j_nghbr;
+  int index;
+  int deltatron_neighbors;
+  int random_int;
+  int max_num_tries = 16;
+
+  index = new_indices[GV_PIXEL (phase1_land, i, j)];
+  if ((landuse_classes[index].trans == TRUE) &&
+      (GV_PIXEL (deltatron, i, j) == 0))
   {
-    if (deltatron[i] > 0)
+    /*
+     *
+     * I,J IS A TRANSITIONAL PIXEL WHICH HAS NOT TRANSITIONED
+     * WITHIN THE LAST MIN_YEARS_BETWEEN_TRANSTIONS YEARS; COUNT
+     * ITS NEIGHBORS WHICH HAVE TRANSITIONED IN THE PREVIOUS
+     * YEAR (IE. DELTATRON == 2)
+     *
+     */
+    deltatron_neighbors = util_count_neighbors (deltatron, i, j, EQ, 2);
+
+    random_int = 1 + RANDOM_INT (2);
+    if (deltatron_neighbors >= random_int)
     {
-      deltatron[i]++;
+      for (k = 0; k < max_num_tries; k++)
+      {
+        util_get_neighbor (i, j, &i_nghbr, &j_nghbr);
+        index = new_indices[GV_PIXEL (phase1_land, i_nghbr, j_nghbr)];
+        if ((GV_PIXEL (deltatron, i_nghbr, j_nghbr) == 2) &&
+            (landuse_classes[index].trans == TRUE))
+        {
+          if (RANDOM_FLOAT < TRANS_PROBABILITY2 (i, j, i_nghbr, j_nghbr))
+          {
+            GV_PIXEL (phase2_land, i, j) =
+              GV_PIXEL (urban_land, i_nghbr, j_nghbr);
+            delta_birth (deltatron, i, j);
+          }
+          /*
+           *
+           * BREAK OUT OF FOR LOOP
+           *
+           */
+          break;
+        }
+        /* end of if( deltatron[OFFSET(i_nghbr,j_nghbr)] == 2) && */
+      }
+      /* end of for(k=0;k<max_num_tries;k++) */
+    }
+    /* end of if (deltatron_neighbors >= random_int) */
+  }
+  /* end of if(( landuse_classes[index].trans == TRUE ) && */
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_InitActiveSet
+** PURPOSE:       empty the deltatron active set
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Called whenever the deltatron grid is cleared. Always
+**                empties the birth log and drops the transition index,
+**                which is rebuilt from the land grid by the next call
+**                of the deltatron. The active set itself is only used
+**                when SPARSE_DELTATRON is set.
+**
+*/
+void
+  delta_InitActiveSet ()
+{
+  birth_log = mem_GetLNDlogptr ();
+  birth_count = 0;
+  indexed = scen_GetIndexedDeltatronCentersFlag ();
+  index_valid = FALSE;
+  if (indexed)
+  {
+    trans_index = mem_GetDTIindexptr ();
+    trans_pos = mem_GetDTIposptr ();
+  }
+  sparse = scen_GetSparseDeltatronFlag ();
+  if (!sparse)
+  {
+    return;
+  }
+  active = mem_GetDASactiveptr ();
+  candidates = mem_GetDAScandidateptr ();
+  candidate_flag = mem_GetDASflagptr ();
+  active_count = 0;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_birth
+** PURPOSE:       set the deltatron of pixel i,j to 1
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   A deltatron which was dead enters the active set. The
+**                first birth of a pixel in a year is logged so that
+**                delta_deltatron copies it back; no deltatron is 1 when
+**                a year starts.
+**
+*/
+static
+  void
+  delta_birth (grid_view * deltatron,                        /* IN/OUT */
+               int i,                                        /* IN     */
+               int j)                                      /* IN     */
+{
+  if (sparse && (GV_PIXEL (deltatron, i, j) == 0))
+  {
+    active[active_count++] = GV_OFFSET (deltatron, i, j);
+  }
+  if (GV_PIXEL (deltatron, i, j) != 1)
+  {
+    birth_log[birth_count++] = GV_OFFSET (deltatron, i, j);
+  }
+  GV_PIXEL (deltatron, i, j) = 1;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_any_transitional
+** PURPOSE:       tell whether the land grid has a transitional pixel
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Without one the phase 1 search for a center would never
+**                end. Stops at the first transitional pixel, so it is
+**                short unless the grid has almost none.
+**
+*/
+static
+  BOOLEAN
+  delta_any_transitional (grid_view * urban_land,            /* IN     */
+                          Classes * landuse_classes,         /* IN     */
+                          int *new_indices)                /* IN     */
+{
+  int total_pixels;
+  int k;
+
+  total_pixels = mem_GetTotalPixels ();
+  for (k = 0; k < total_pixels; k++)
+  {
+    if (landuse_classes[new_indices[urban_land->ptr[k]]].trans == TRUE)
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_index_build
+** PURPOSE:       build the transition index from the land grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Afterwards delta_land_set keeps the index up to date.
+**
+**
+*/
+static
+  void
+  delta_index_build (grid_view * urban_land,                 /* IN     */
+                     Classes * landuse_classes,              /* IN     */
+                     int *new_indices)                     /* IN     */
+{
+  int total_pixels;
+  int k;
+
+  total_pixels = mem_GetTotalPixels ();
+  trans_count = 0;
+  for (k = 0; k < total_pixels; k++)
+  {
+    trans_pos[k] = -1;
+    delta_index_update (k, urban_land->ptr, landuse_classes, new_indices);
+  }
+  index_valid = TRUE;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_land_set
+** PURPOSE:       set one pixel of both land grids
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The pixel is recorded as changed for delta_InitLand and
+**                the transition index is updated.
+**
+*/
+static
+  void
+  delta_land_set (int offset,                                /* IN     */
+                  PIXEL value,                               /* IN     */
+                  GRID_P land1,                              /* IN/OUT */
+                  GRID_P land2,                              /* IN/OUT */
+                  Classes * landuse_classes,                 /* IN     */
+                  int *new_indices)                        /* IN     */
+{
+  land1[offset] = value;
+  land2[offset] = value;
+  if (!changed_flag[offset])
+  {
+    changed_flag[offset] = 1;
+    changed[changed_count++] = offset;
+  }
+  if (indexed && index_valid)
+  {
+    delta_index_update (offset, land1, landuse_classes, new_indices);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_InitLand
+** PURPOSE:       initialize both land grids from a land use grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   source is land use grid source_index. When the grids were
+**                last initialized from the same land use grid, only the
+**                pixels changed since then are copied.
+**
+*/
+void
+  delta_InitLand (GRID_P source,                             /* IN     */
+                  int source_index,                          /* IN     */
+                  GRID_P land1,                              /* OUT    */
+                  GRID_P land2)                            /* OUT    */
+{
+  int total_pixels;
+  int offset;
+  int k;
+
+  changed = mem_GetLNDdirtyptr ();
+  changed_flag = mem_GetLNDflagptr ();
+  if (source_index == land_source)
+  {
+    for (k = 0; k < changed_count; k++)
+    {
+      offset = changed[k];
+      land1[offset] = source[offset];
+      land2[offset] = source[offset];
+      changed_flag[offset] = 0;
+    }
+  }
+  else
+  {
+    total_pixels = mem_GetTotalPixels ();
+    for (k = 0; k < total_pixels; k++)
+    {
+      land1[k] = source[k];
+      land2[k] = source[k];
+    }
+    for (k = 0; k < changed_count; k++)
+    {
+      changed_flag[changed[k]] = 0;
+    }
+  }
+  changed_count = 0;
+  land_source = source_index;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_ConditionUrban
+** PURPOSE:       place the urban growth into both land grids
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Sets every pixel where z is not zero to urban_code. Only
+**                visits the cumulative growth arrays when they describe z.
+**
+*/
+void
+  delta_ConditionUrban (GRID_P z,                            /* IN     */
+                        GRID_P land1,                        /* IN/OUT */
+                        GRID_P land2,                        /* IN/OUT */
+                        int urban_code)                    /* IN     */
+{
+  COORD_TYPE *urban_row;
+  COORD_TYPE *urban_col;
+  Classes *landuse_classes;
+  int *new_indices;
+  int offset;
+  int count;
+  int k;
+
+  landuse_classes = landclass_GetClassesPtr ();
+  new_indices = landclass_GetNewIndicesPtr ();
+  if (z == mem_GetGRZpointer ())
+  {
+    urban_row = mem_GetGRZrowptr ();
+    urban_col = mem_GetGRZcolptr ();
+    count = mem_GetGRZcount ();
+    for (k = 0; k < count; k++)
+    {
+      offset = OFFSET (urban_row[k], urban_col[k]);
+      if ((z[offset] > 0) && (land1[offset] != urban_code))
+      {
+        delta_land_set (offset, urban_code, land1, land2,
+                        landuse_classes, new_indices);
+      }
+    }
+  }
+  else
+  {
+    count = mem_GetTotalPixels ();
+    for (offset = 0; offset < count; offset++)
+    {
+      if ((z[offset] > 0) && (land1[offset] != urban_code))
+      {
+        delta_land_set (offset, urban_code, land1, land2,
+                        landuse_classes, new_indices);
+      }
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_index_update
+** PURPOSE:       add or remove one pixel of the transition index
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   A removed pixel is replaced by the last one of the index.
+**
+*/
+static
+  void
+  delta_index_update (int offset,                            /* IN     */
+                      GRID_P land,                           /* IN     */
+                      Classes * landuse_classes,             /* IN     */
+                      int *new_indices)                    /* IN     */
+{
+  int last;
+
+  if (landuse_classes[new_indices[land[offset]]].trans == TRUE)
+  {
+    if (trans_pos[offset] < 0)
+    {
+      trans_pos[offset] = trans_count;
+      trans_index[trans_count++] = offset;
+    }
+  }
+  else if (trans_pos[offset] >= 0)
+  {
+    last = trans_index[--trans_count];
+    trans_index[trans_pos[offset]] = last;
+    trans_pos[last] = trans_pos[offset];
+    trans_pos[offset] = -1;
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: delta_age
+** PURPOSE:       age the deltatrons and kill the old ones
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   One pass, over the active set when SPARSE_DELTATRON is
+**                set and over the grid otherwise.
+**
+**                E-Mail from: Jeannette Candau
+**                Date: Mon, 20 Dec 1999 14:33:46 -0800
+**                The count of the deltatrons is, as you said, a track of
+**                how many "years" it has been since a transition has
+**                occured at a pixel location. If a tranition occurs in
+**                phase1 the deltatron value of that pixel will be 1. At
+**                the end of deltatron() it is aged. So what phase2 does
+**                with "deltatron == 2" is look for neighborhood change
+**                that has occured in the previous year. The value of
+**                "MIN_YEARS_BETWEEN_TRANSITIONS" is a control on how many
+**                years must pass before another transition may occur at
+**                (i,j).
+*/
+static
+  void
+  delta_age (grid_view * deltatron)                        /* IN/OUT */
+{
+  GRID_P ptr;
+  int total_pixels;
+  int k;
+
+  ptr = deltatron->ptr;
+  if (sparse)
+  {
+    k = 0;
+    while (k < active_count)
+    {
+      if (++ptr[active[k]] > MIN_YEARS_BETWEEN_TRANSITIONS)
+      {
+        ptr[active[k]] = 0;
+        active[k] = active[--active_count];
+      }
+      else
+      {
+        k++;
+      }
+    }
+    return;
+  }
+
+  total_pixels = mem_GetTotalPixels ();
+  for (k = 0; k < total_pixels; k++)
+  {
+    if (ptr[k] > 0)
+    {
+      ptr[k]++;
+      if (ptr[k] > MIN_YEARS_BETWEEN_TRANSITIONS)
+      {
+        ptr[k] = 0;
+      }
     }
   }
-  /*
-   *
-   * KILL OLD DELTATRONS
-   *
-   * E-Mail from: Jeannette Candau
-   * Date: Mon, 20 Dec 1999 14:33:46 -0800
-   * The count of the deltatrons is, as you said, a track of how
-   * many "years" it has been since a transition has occured at a
-   * pixel location. If a tranition occurs in phase1 the
-   * deltatron value of that pixel will be 1. At the end of
-   * deltatron() it is aged. So what phase2 does with "deltatron
-   * == 2" is look for neighborhood change that has occured in
-   * the previous year. The value of "MIN_YEARS_BETWEEN_TRANSITIONS"
-   * is a control on how many
-   * years must pass before another transition may occur at
-   * (i,j).
-   */
-  util_condition_gif (mem_GetTotalPixels (),
-                      deltatron,
-                      GT,
-                      MIN_YEARS_BETWEEN_TRANSITIONS,
-                      deltatron,
-                      0);
-  FUNC_END;
-  timer_Stop (DELTA_PHASE2);
 }
@@ -13,13 +13,24 @@ void
   delta_deltatron (int *new_indices,                               /* IN     */
                    Classes * landuse_classes,                      /* IN     */
                    Classes * class_indices,                        /* IN     */
-                   GRID_P workspace1,                             /* MOD    */
                    GRID_P deltatron,                              /* IN/OUT */
-                   GRID_P urban_land,                             /* IN     */
-                   GRID_P land_out,                               /* OUT    */
+                   GRID_P urban_land,                             /* IN/OUT */
+                   GRID_P land_out,                               /* IN/OUT */
                    GRID_P slp,                                    /* IN     */
                    int drive,                                      /* IN     */
                    CLASS_SLP_TYPE* class_slope,                    /* IN     */
                    FTRANS_TYPE* ftransition);                      /* IN     */
+void
+  delta_InitActiveSet ();
+void
+  delta_InitLand (GRID_P source,                                  /* IN     */
+                  int source_index,                               /* IN     */
+                  GRID_P land1,                                   /* OUT    */
+                  GRID_P land2);                                  /* OUT    */
+void
+  delta_ConditionUrban (GRID_P z,                                 /* IN     */
+                        GRID_P land1,                             /* IN/OUT */
+                        GRID_P land2,                             /* IN/OUT */
+                        int urban_code);                          /* IN     */
 
 #endif
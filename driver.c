@@ -48,6 +48,8 @@
 #include "gdif_obj.h"
 #include "growth.h"
 #include "stats_obj.h"
+#include "egrid_obj.h"
+#include "cgrid_obj.h"
 #include "timer_obj.h"
 #include "color_obj.h"
 
@@ -123,7 +125,7 @@ void
 
   /*
    *
-   * CREATE ANNUAL LANDUSE PROBABILITY FILE
+   * CLEAR ANNUAL LANDUSE CLASS COUNTS
    *
    */
   if (proc_GetProcessingType () == PREDICTING)
@@ -247,7 +249,6 @@ static
 {
   char func[] = "drv_monte_carlo";
   int imc;
-  int i;
   double *class_slope;
   double *ftransition;
   GRID_P z_ptr;
@@ -255,6 +256,7 @@ static
   int num_monte_carlo;
   int *new_indices;
   GRID_P road_state_ptr;
+  ACCUM_P cumulate_count;
 
   FUNC_INIT;
   class_slope = trans_GetClassSlope ();
@@ -315,6 +317,18 @@ static
       }
     }
 
+    /*
+     *
+     * COMPLETE THE CONTROL YEAR STATISTICS OF THIS GROUP OF REPLICATES
+     *
+     */
+    if (scen_GetBitSlicedEnsembleFlag () &&
+        ((imc % EGRID_REPLICATES == EGRID_REPLICATES - 1) ||
+         (imc == num_monte_carlo - 1)))
+    {
+      stats_FlushEnsemble ();
+    }
+
     /*
      *
      * UPDATE CUMULATE GRID
@@ -324,13 +338,12 @@ static
 ***                           processing during calibration.               **/
     if (proc_GetProcessingType () != CALIBRATING)
     {
-    for (i = 0; i < total_pixels; i++)
-    {
-      if (z_ptr[i] > 0)
+      cumulate_count = cgrid_GetMonteCarloPtr ();
+      if (imc == 0)
       {
-        cumulate_ptr[i]++;
+        util_init_accum (cumulate_count);
       }
-    }
+      util_accumulate_positive (z_ptr, cumulate_count);
     }
 
     /*
@@ -353,10 +366,8 @@ static
 ***                           processing during calibration.               **/
   if (proc_GetProcessingType () != CALIBRATING)
   {
-  for (i = 0; i < total_pixels; i++)
-  {
-    cumulate_ptr[i] = (100.0 * cumulate_ptr[i]) / num_monte_carlo;
-  }
+    util_normalize_accum (cgrid_GetMonteCarloPtr (), 100, num_monte_carlo,
+                          cumulate_ptr);
   }
   FUNC_END;
 }
@@ -0,0 +1,372 @@
+/*******************************************************************************
+
+  MODULE:                   egrid_obj.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This module is a pseudo-object which stores the urban state of up
+     to EGRID_REPLICATES Monte Carlo replicates as the bit-planes of one
+     word per pixel, for every urban control year, and computes the
+     area, edge and Lee-Sallee counts of all the replicates in a single
+     sweep with bitwise arithmetic.
+
+  NOTES:
+
+     The ensemble grids are only allocated when BIT_SLICED_ENSEMBLE(YES/NO)
+     is set to YES in the scenario file. The growth rules themselves are
+     still applied one replicate at a time (each replicate has its own
+     road network and coefficients); stats_Update deposits the Z grid of
+     every replicate at the control years and stats_FlushEnsemble
+     completes the deferred counts once per group of replicates.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "globals.h"
+#include "igrid_obj.h"
+#include "proc_obj.h"
+#include "scenario_obj.h"
+#include "ugm_macros.h"
+#include "egrid_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static int nrows;
+static int ncols;
+static EGRID_WORD *ensemble_bits[MAX_URBAN_YEARS];
+static EGRID_WORD area_planes[EGRID_COUNTER_BITS];
+static EGRID_WORD edge_planes[EGRID_COUNTER_BITS];
+static EGRID_WORD intersection_planes[EGRID_COUNTER_BITS];
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                        STATIC FUNCTION PROTOTYPES                         **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static void egrid_add (EGRID_WORD * planes, EGRID_WORD mask);
+static int egrid_extract (EGRID_WORD * planes, int replicate);
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_Init
+** PURPOSE:       allocate the ensemble grids of the urban control years
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Must be called after the input grids have been read.
+**                Does nothing when the bit-sliced ensemble option is off.
+**                The first urban grid is the seed and is never simulated,
+**                so it gets no ensemble grid.
+**
+*/
+void
+  egrid_Init ()
+{
+  char func[] = "egrid_Init";
+  size_t bytes_per_grid;
+  int i;
+
+  if (!scen_GetBitSlicedEnsembleFlag ())
+  {
+    return;
+  }
+
+  nrows = igrid_GetNumRows ();
+  ncols = igrid_GetNumCols ();
+  bytes_per_grid = (size_t) nrows * ncols * sizeof (EGRID_WORD);
+
+  for (i = 1; i < igrid_GetUrbanCount (); i++)
+  {
+    ensemble_bits[i] = malloc (bytes_per_grid);
+    if (ensemble_bits[i] == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %llu bytes of memory (ensemble)",
+               (unsigned long long) bytes_per_grid);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    memset (ensemble_bits[i], 0, bytes_per_grid);
+  }
+
+  if (scen_GetLogFlag ())
+  {
+    scen_Append2Log ();
+    fprintf (scen_GetLogFP (),
+             "%s %u Allocated %llu bytes of memory (ensemble grids)\n",
+             __FILE__, __LINE__,
+             (unsigned long long) (igrid_GetUrbanCount () - 1) * bytes_per_grid);
+    scen_CloseLog ();
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_MemoryLog
+** PURPOSE:       log memory map to FILE* fp
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  egrid_MemoryLog (FILE * fp)
+{
+  LOG_MEM (fp, &ensemble_bits[0], sizeof (EGRID_WORD *), MAX_URBAN_YEARS);
+  LOG_MEM (fp, &area_planes[0], sizeof (EGRID_WORD), EGRID_COUNTER_BITS);
+  LOG_MEM (fp, &edge_planes[0], sizeof (EGRID_WORD), EGRID_COUNTER_BITS);
+  LOG_MEM (fp, &intersection_planes[0], sizeof (EGRID_WORD),
+           EGRID_COUNTER_BITS);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_IsDeferredYear
+** PURPOSE:       true if the edge and Lee-Sallee counts of year are
+**                computed on the ensemble grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Only urban control years outside of prediction are
+**                deferred, which are the only years whose statistics
+**                are saved while calibrating or testing.
+**
+*/
+BOOLEAN
+  egrid_IsDeferredYear (int year)
+{
+  if (!scen_GetBitSlicedEnsembleFlag ())
+  {
+    return FALSE;
+  }
+  if (proc_GetProcessingType () == PREDICTING)
+  {
+    return FALSE;
+  }
+  return igrid_TestForUrbanYear (year);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_Deposit
+** PURPOSE:       store the urban pixels of a replicate in its bit-plane
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   rows/cols list every pixel which may be urban in z (the
+**                cumulative growth list), so only those are visited.
+**                The bit-plane must be clear, which egrid_CountStats
+**                ensures for the next group of replicates.
+**
+*/
+void
+  egrid_Deposit (int index,                                  /* IN     */
+                 int replicate,                              /* IN     */
+                 GRID_P z,                                   /* IN     */
+                 COORD_TYPE * rows,                          /* IN     */
+                 COORD_TYPE * cols,                          /* IN     */
+                 int count)                                /* IN     */
+{
+  char func[] = "egrid_Deposit";
+  EGRID_WORD *bits;
+  EGRID_WORD bit;
+  int offset;
+  int k;
+
+  if ((index < 1) || (index >= igrid_GetUrbanCount ()))
+  {
+    sprintf (msg_buf, "index = %d is out of range", index);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  if ((replicate < 0) || (replicate >= EGRID_REPLICATES))
+  {
+    sprintf (msg_buf, "replicate = %d is out of range", replicate);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  bits = ensemble_bits[index];
+  bit = ((EGRID_WORD) 1) << replicate;
+  for (k = 0; k < count; k++)
+  {
+    offset = rows[k] * ncols + cols[k];
+    if (z[offset] != 0)
+    {
+      bits[offset] |= bit;
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_CountStats
+** PURPOSE:       count area, edges and Lee-Sallee terms of every replicate
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Same results, replicate by replicate, as stats_edge (a
+**                set pixel is an edge if one of its N, S, E, W neighbors
+**                inside the image is not set) and stats_compute_leesalee
+**                against the urban control grid of index. Each pixel word
+**                yields the masks of the replicates for which it is set,
+**                an edge and in the intersection; the masks are summed
+**                into bit-sliced counters. The ensemble grid is cleared
+**                afterwards.
+**
+*/
+void
+  egrid_CountStats (int index,                               /* IN     */
+                    int num_replicates,                      /* IN     */
+                    int *area,                               /* OUT    */
+                    int *edges,                              /* OUT    */
+                    int *intersection,                       /* OUT    */
+                    int *the_union)                        /* OUT    */
+{
+  char func[] = "egrid_CountStats";
+  GRID_P urban_ptr;
+  EGRID_WORD *bits;
+  EGRID_WORD *cur;
+  EGRID_WORD all;
+  EGRID_WORD c;
+  EGRID_WORD north;
+  EGRID_WORD south;
+  EGRID_WORD west;
+  EGRID_WORD east;
+  int urban_area;
+  int row;
+  int col;
+  int r;
+
+  FUNC_INIT;
+  assert (area != NULL);
+  assert (edges != NULL);
+  assert (intersection != NULL);
+  assert (the_union != NULL);
+  assert ((num_replicates > 0) && (num_replicates <= EGRID_REPLICATES));
+  assert ((index >= 1) && (index < igrid_GetUrbanCount ()));
+
+  bits = ensemble_bits[index];
+  urban_ptr = igrid_GetUrbanGridPtr (__FILE__, func, __LINE__, index);
+  memset (area_planes, 0, sizeof (area_planes));
+  memset (edge_planes, 0, sizeof (edge_planes));
+  memset (intersection_planes, 0, sizeof (intersection_planes));
+
+  all = ~((EGRID_WORD) 0);
+  urban_area = 0;
+  for (row = 0; row < nrows; row++)
+  {
+    cur = bits + row * ncols;
+    for (col = 0; col < ncols; col++)
+    {
+      if (urban_ptr[row * ncols + col] != 0)
+      {
+        urban_area++;
+      }
+      c = cur[col];
+      if (c == 0)
+      {
+        continue;
+      }
+      north = (row > 0) ? cur[col - ncols] : all;
+      south = (row < nrows - 1) ? cur[col + ncols] : all;
+      west = (col > 0) ? cur[col - 1] : all;
+      east = (col < ncols - 1) ? cur[col + 1] : all;
+
+      egrid_add (area_planes, c);
+      egrid_add (edge_planes, c & ~(north & south & west & east));
+      if (urban_ptr[row * ncols + col] != 0)
+      {
+        egrid_add (intersection_planes, c);
+      }
+    }
+  }
+  urban_ptr = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr);
+
+  for (r = 0; r < num_replicates; r++)
+  {
+    area[r] = egrid_extract (area_planes, r);
+    edges[r] = egrid_extract (edge_planes, r);
+    intersection[r] = egrid_extract (intersection_planes, r);
+    the_union[r] = area[r] + urban_area - intersection[r];
+  }
+
+  memset (bits, 0, (size_t) nrows * ncols * sizeof (EGRID_WORD));
+  FUNC_END;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_add
+** PURPOSE:       add one to the counters of the replicates set in mask
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Ripple-carry increment of the bit-sliced counters; the
+**                carry usually dies out after a plane or two.
+**
+*/
+static void
+  egrid_add (EGRID_WORD * planes,                            /* IN/OUT */
+             EGRID_WORD mask)                              /* IN     */
+{
+  EGRID_WORD carry;
+  int p;
+
+  for (p = 0; (mask != 0) && (p < EGRID_COUNTER_BITS); p++)
+  {
+    carry = planes[p] & mask;
+    planes[p] ^= mask;
+    mask = carry;
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: egrid_extract
+** PURPOSE:       return the counter of one replicate
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static int
+  egrid_extract (EGRID_WORD * planes,                        /* IN     */
+                 int replicate)                            /* IN     */
+{
+  unsigned int value;
+  int p;
+
+  value = 0;
+  for (p = 0; p < EGRID_COUNTER_BITS; p++)
+  {
+    value |= (unsigned int) ((planes[p] >> replicate) & 1) << p;
+  }
+  return (int) value;
+}
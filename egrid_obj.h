@@ -0,0 +1,35 @@
+#ifndef EGRID_OBJ_H
+#define EGRID_OBJ_H
+#include <stdio.h>
+#include "ugm_defines.h"
+#include "bgrid_obj.h"
+
+/*
+ *
+ * An egrid is a bit-sliced ensemble grid: one word per pixel, bit r of
+ * the word holding the urban state (pixel > 0) of Monte Carlo replicate
+ * r. Up to EGRID_REPLICATES replicates share a grid. Counts over the
+ * grid are kept in EGRID_COUNTER_BITS bit-planes, plane p holding bit p
+ * of the count of every replicate.
+ *
+ */
+#define EGRID_WORD BGRID_WORD
+#define EGRID_REPLICATES BGRID_BITS
+#define EGRID_COUNTER_BITS 32
+
+void egrid_Init ();
+void egrid_MemoryLog (FILE * fp);
+BOOLEAN egrid_IsDeferredYear (int year);
+void egrid_Deposit (int index,
+                    int replicate,
+                    GRID_P z,
+                    COORD_TYPE * rows,
+                    COORD_TYPE * cols,
+                    int count);
+void egrid_CountStats (int index,
+                       int num_replicates,
+                       int *area,
+                       int *edges,
+                       int *intersection,
+                       int *the_union);
+#endif
@@ -12,6 +12,9 @@ module.
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#ifndef _MSC_VER
+  #include <pthread.h>
+#endif
 #include "gd.h"
 #include "gdfonts.h"
 #include "gdfontg.h"
@@ -21,6 +24,7 @@ module.
 #include "igrid_obj.h"
 #include "timer_obj.h"
 #include "scenario_obj.h"
+#include "gifq_obj.h"
 #include "ugm_macros.h"
 
 /*****************************************************************************\
@@ -32,6 +36,27 @@ module.
 \*****************************************************************************/
 char gdif_obj_c_sccs_id[] = "@(#)gdif_obj.c	1.84	12/4/00";
 
+/*
+ *
+ * GD'S GIF ENCODER IS NOT REENTRANT; THE IMAGE WRITER THREADS OF
+ * gifq_obj.c AND THE MAIN THREAD TAKE TURNS
+ *
+ */
+#ifndef _MSC_VER
+static pthread_mutex_t gif_encoder = PTHREAD_MUTEX_INITIALIZER;
+#define GDIF_ENCODER_LOCK pthread_mutex_lock (&gif_encoder)
+#define GDIF_ENCODER_UNLOCK pthread_mutex_unlock (&gif_encoder)
+#else
+#define GDIF_ENCODER_LOCK
+#define GDIF_ENCODER_UNLOCK
+#endif
+
+static int gdif_read_pgm_header (FILE * fp, int *nrows, int *ncols,
+                                 int *maxval);
+static int gdif_read_pgm_int (FILE * fp);
+static void gdif_write_ppm (GRID_P grid, struct colortable *colortable,
+                            char fname[]);
+
 
 
 /******************************************************************************
@@ -126,7 +151,9 @@ void
    * OUTPUT THE GIF TO DISK
    *
    */
+  GDIF_ENCODER_LOCK;
   gdImageGif (im_out, fp);
+  GDIF_ENCODER_UNLOCK;
   /*
    *
    * CLOSE THE OUTPUT FILE
@@ -149,8 +176,8 @@ void
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   The image is handed to the output queue when it is
+**                running (see gifq_obj.c), and encoded here otherwise.
 **
 */
 void
@@ -163,10 +190,6 @@ void
   )
 {
   char func[] = "qgdif_WriteGIF";
-  gdImagePtr im_out;
-  FILE *fp;
-  int i;
-  int j;
   timer_Start (GDIF_WRITEGIF);
   assert (gif != NULL);
   assert (colortable != NULL);
@@ -197,6 +220,54 @@ void
       scen_CloseLog ();
     }
   }
+
+  if (!gifq_Push (gif, colortable, fname, date, date_color_index))
+  {
+    gdif_EncodeGIF (gif, colortable, fname, date, date_color_index);
+  }
+  FUNC_END;
+  timer_Stop (GDIF_WRITEGIF);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_EncodeGIF
+** PURPOSE:       map, encode and write an GIF image
+** AUTHOR:        Keith Clarke
+** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
+** CREATION DATE: 11/11/1999
+** DESCRIPTION:   The body of gdif_WriteGIF, also run by the image writer
+**                threads: it neither logs nor times. GD's GIF encoder
+**                keeps its state in statics, so gdImageGif is serialized.
+**
+*/
+void
+  gdif_EncodeGIF (
+                   GRID_P gif,
+                   struct colortable *colortable,
+                   char fname[],
+                   char date[],
+                   int date_color_index
+  )
+{
+  char func[] = "gdif_EncodeGIF";
+  gdImagePtr im_out;
+  FILE *fp;
+  int i;
+  int j;
+
+  /*
+   *
+   * GIF STORES ITS SIZES ON 16 BITS; LARGER GRIDS GO TO A PPM
+   *
+   */
+  if ((igrid_GetNumRows () > GIF_MAX_SIDE) ||
+      (igrid_GetNumCols () > GIF_MAX_SIDE))
+  {
+    gdif_write_ppm (gif, colortable, fname);
+    return;
+  }
+
   /*
    *
    * OPEN OUTPUT GIF FILE
@@ -251,7 +322,9 @@ void
    * OUTPUT THE GIF TO DISK
    *
    */
+  GDIF_ENCODER_LOCK;
   gdImageGif (im_out, fp);
+  GDIF_ENCODER_UNLOCK;
   /*
    *
    * CLOSE THE OUTPUT FILE
@@ -265,8 +338,6 @@ void
    *
    */
   gdImageDestroy (im_out);
-  FUNC_END;
-  timer_Stop (GDIF_WRITEGIF);
 }
 
 /******************************************************************************
@@ -388,3 +459,240 @@ void
   FUNC_END;
   timer_Stop (GDIF_READGIF);
 }
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_read_pgm_int
+** PURPOSE:       read one ASCII header field of a PGM file
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   skips white space and '#' comment lines, then reads a
+**                decimal number. Returns -1 if no number is found.
+**
+*/
+static int
+  gdif_read_pgm_int (FILE * fp)
+{
+  int c;
+  int value;
+
+  c = fgetc (fp);
+  while ((c == '#') || (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'))
+  {
+    if (c == '#')
+    {
+      while ((c != '\n') && (c != EOF))
+      {
+        c = fgetc (fp);
+      }
+    }
+    c = fgetc (fp);
+  }
+  if ((c < '0') || (c > '9'))
+  {
+    return -1;
+  }
+  value = 0;
+  while ((c >= '0') && (c <= '9'))
+  {
+    value = 10 * value + (c - '0');
+    c = fgetc (fp);
+  }
+  return value;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_read_pgm_header
+** PURPOSE:       read the header of a binary (P5) PGM file
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   returns TRUE and leaves fp on the first pixel byte if the
+**                file is a P5 PGM, FALSE otherwise.
+**
+*/
+static int
+  gdif_read_pgm_header (FILE * fp, int *nrows, int *ncols, int *maxval)
+{
+  if ((fgetc (fp) != 'P') || (fgetc (fp) != '5'))
+  {
+    return FALSE;
+  }
+  *ncols = gdif_read_pgm_int (fp);
+  *nrows = gdif_read_pgm_int (fp);
+  *maxval = gdif_read_pgm_int (fp);
+  if ((*ncols <= 0) || (*nrows <= 0) || (*maxval <= 0))
+  {
+    return FALSE;
+  }
+  return TRUE;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_ReadPGMSize
+** PURPOSE:       get the size of a PGM input grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   PGM has no 16 bit size limit, so it is the input format
+**                for grids wider or taller than a GIF can hold.
+**                Returns FALSE if fname is not a P5 PGM file.
+**
+*/
+int
+  gdif_ReadPGMSize (char *fname, int *nrows, int *ncols)
+{
+  char func[] = "gdif_ReadPGMSize";
+  FILE *fp;
+  int maxval;
+  int is_pgm;
+
+  FILE_OPEN (fp, fname, "rb");
+  is_pgm = gdif_read_pgm_header (fp, nrows, ncols, &maxval);
+  fclose (fp);
+  return is_pgm;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_ReadPGM
+** PURPOSE:       read a binary (P5) 8 bit PGM image into a grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   the PGM counterpart of gdif_ReadGIF. Gray levels are
+**                stored as they are, one byte per pixel.
+**
+*/
+void
+  gdif_ReadPGM (GRID_P pgm_ptr, char *fname)
+{
+  char func[] = "gdif_ReadPGM";
+  FILE *in;
+  int row;
+  int col;
+  int maxval;
+  int i;
+
+  timer_Start (GDIF_READGIF);
+  FUNC_INIT;
+  assert (pgm_ptr != NULL);
+  assert (igrid_GetNumRows () > 0);
+  assert (igrid_GetNumCols () > 0);
+
+  if (scen_GetLogFlag ())
+  {
+    if (scen_GetLogWritesFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "\n%s %s %d \nreading PGM %s\n",
+               __FILE__, func, __LINE__, fname);
+      fprintf (scen_GetLogFP (), "rows=%u cols=%u storage pointer = %d\n",
+               igrid_GetNumRows (), igrid_GetNumCols (), pgm_ptr);
+      fprintf (scen_GetLogFP (), "\n");
+      scen_CloseLog ();
+    }
+  }
+
+  FILE_OPEN (in, fname, "rb");
+  if (!gdif_read_pgm_header (in, &row, &col, &maxval))
+  {
+    sprintf (msg_buf, "file:%s is not a binary (P5) PGM image\n", fname);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  if (maxval > 255)
+  {
+    sprintf (msg_buf, "file:%s has maxval %d; only 8 bit PGM is supported\n",
+             fname, maxval);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  if ((row != igrid_GetNumRows ()) || (col != igrid_GetNumCols ()))
+  {
+    sprintf (msg_buf, "%4uX%4u image doesn't match expected size %4uX%4u\n",
+             row, col, igrid_GetNumRows (), igrid_GetNumCols ());
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  for (i = 0; i < row; i++)
+  {
+    if (fread (&pgm_ptr[OFFSET (i, 0)], sizeof (PIXEL), col, in) != (size_t) col)
+    {
+      sprintf (msg_buf, "file:%s is truncated at row %d\n", fname, i);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+  }
+  fclose (in);
+
+  FUNC_END;
+  timer_Stop (GDIF_READGIF);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gdif_write_ppm
+** PURPOSE:       write a grid as a binary (P6) PPM image
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   used by gdif_WriteGIF when the grid is too large for a
+**                GIF. The colortable is applied as it would be in the GIF;
+**                a trailing ".gif" in fname becomes ".ppm". No date string
+**                is drawn. Like gdif_EncodeGIF it may run on an image
+**                writer thread, so it does not log.
+**
+*/
+static void
+  gdif_write_ppm (GRID_P grid, struct colortable *colortable, char fname[])
+{
+  char func[] = "gdif_write_ppm";
+  char ppm_name[MAX_FILENAME_LEN];
+  unsigned char *line;
+  FILE *fp;
+  int len;
+  int i;
+  int j;
+  int index;
+
+  strncpy (ppm_name, fname, MAX_FILENAME_LEN - 1);
+  ppm_name[MAX_FILENAME_LEN - 1] = '\0';
+  len = strlen (ppm_name);
+  if ((len > 4) && (strcmp (&ppm_name[len - 4], ".gif") == 0))
+  {
+    strcpy (&ppm_name[len - 4], ".ppm");
+  }
+
+  line = (unsigned char *) malloc (3 * igrid_GetNumCols ());
+  if (line == NULL)
+  {
+    sprintf (msg_buf, "Unable to allocate %u bytes of memory (PPM row)",
+             3 * igrid_GetNumCols ());
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  FILE_OPEN (fp, ppm_name, "wb");
+  fprintf (fp, "P6\n%d %d\n255\n", igrid_GetNumCols (), igrid_GetNumRows ());
+  for (i = 0; i < igrid_GetNumRows (); i++)
+  {
+    for (j = 0; j < igrid_GetNumCols (); j++)
+    {
+      index = (int) grid[OFFSET (i, j)];
+      if (index >= colortable->size)
+      {
+        index = colortable->size - 1;
+      }
+      line[3 * j] = (unsigned char) colortable->color[index].red;
+      line[3 * j + 1] = (unsigned char) colortable->color[index].green;
+      line[3 * j + 2] = (unsigned char) colortable->color[index].blue;
+    }
+    fwrite (line, 1, 3 * igrid_GetNumCols (), fp);
+  }
+  fclose (fp);
+  free (line);
+}
@@ -14,11 +14,19 @@
 
 void gdif_WriteColorKey ( struct colortable *colortable, char fname[]);
 void gdif_ReadGIF (GRID_P gif_ptr, char *fname);
+int gdif_ReadPGMSize (char *fname, int *nrows, int *ncols);
+void gdif_ReadPGM (GRID_P pgm_ptr, char *fname);
 void gdif_WriteGIF(
                   GRID_P gif,
                   struct colortable *colortable,
                   char fname[],
                   char date[],
                   int date_color_index);
+void gdif_EncodeGIF(
+                  GRID_P gif,
+                  struct colortable *colortable,
+                  char fname[],
+                  char date[],
+                  int date_color_index);
 
 #endif
@@ -0,0 +1,441 @@
+/*******************************************************************************
+
+  MODULE:                   gifq_obj.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This module is a pseudo-object which queues the images written by
+     gdif_WriteGIF, so that the colortable mapping, the GIF encoding and
+     the file I/O run on background writer threads instead of stalling
+     the simulation every year of every Monte Carlo iteration.
+
+  NOTES:
+
+     The queue is only started when OUTPUT_WRITER_THREADS is set in the
+     scenario file. Each queued image is a copy of the grid in a snapshot
+     buffer of a fixed pool; buffers are recycled once their image is
+     written. When no buffer is free the image is written by the caller,
+     so memory stays bounded and the simulation never waits on the queue.
+
+     An image is only queued when no queued image has the same file
+     name, so a file always ends up with its last image. gifq_Shutdown
+     must be called before the output directory is read (whirlgif,
+     runall.bat) and before exiting.
+
+     The threads are POSIX threads; under MSVC the images are always
+     written by the caller.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _MSC_VER
+  #include <pthread.h>
+#endif
+#include "globals.h"
+#include "memory_obj.h"
+#include "scenario_obj.h"
+#include "gdif_obj.h"
+#include "ugm_macros.h"
+#include "gifq_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+typedef struct
+{
+  GRID_P grid;
+  struct colortable *colortable;
+  char fname[MAX_FILENAME_LEN];
+  char date[GIFQ_DATE_LEN];
+  int date_color_index;
+  BOOLEAN in_flight;
+} gifq_job;
+
+static gifq_job jobs[GIFQ_MAX_BUFFERS];
+static int free_stack[GIFQ_MAX_BUFFERS];
+static int ring[GIFQ_MAX_BUFFERS];
+static int num_buffers;
+static int num_free;
+static int num_pending;
+static int num_busy;
+static int head;
+static int tail;
+static int num_threads;
+static int inline_writes;
+static BOOLEAN stopping;
+#ifndef _MSC_VER
+static pthread_t threads[GIFQ_MAX_BUFFERS];
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_ready = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t idle = PTHREAD_COND_INITIALIZER;
+#endif
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                        STATIC FUNCTION PROTOTYPES                         **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+#ifndef _MSC_VER
+static void *gifq_writer (void *arg);
+static BOOLEAN gifq_name_in_flight (char fname[]);
+#endif
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_Init
+** PURPOSE:       allocate the snapshot buffers and start the writers
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Does nothing unless OUTPUT_WRITER_THREADS is set.
+**
+**
+*/
+void
+  gifq_Init ()
+{
+#ifndef _MSC_VER
+  char func[] = "gifq_Init";
+  size_t budget;
+  int budget_mb;
+  int i;
+  int rc;
+
+  if (scen_GetOutputWriterThreads () <= 0)
+  {
+    return;
+  }
+
+  budget_mb = scen_GetOutputQueueMB ();
+  if (budget_mb <= 0)
+  {
+    budget_mb = GIFQ_DEFAULT_QUEUE_MB;
+  }
+  budget = (size_t) budget_mb * 1024 * 1024;
+  num_buffers = (int) (budget / ((size_t) mem_GetTotalPixels () *
+                                 sizeof (PIXEL)));
+  if (num_buffers < 1)
+  {
+    num_buffers = 1;
+  }
+  if (num_buffers > GIFQ_MAX_BUFFERS)
+  {
+    num_buffers = GIFQ_MAX_BUFFERS;
+  }
+
+  for (i = 0; i < num_buffers; i++)
+  {
+    jobs[i].grid = malloc (mem_GetTotalPixels () * sizeof (PIXEL));
+    if (jobs[i].grid == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (gifq)",
+               (unsigned int) (mem_GetTotalPixels () * sizeof (PIXEL)));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    jobs[i].in_flight = FALSE;
+    free_stack[i] = i;
+  }
+  num_free = num_buffers;
+
+  num_threads = scen_GetOutputWriterThreads ();
+  if (num_threads > num_buffers)
+  {
+    num_threads = num_buffers;
+  }
+  for (i = 0; i < num_threads; i++)
+  {
+    rc = pthread_create (&threads[i], NULL, gifq_writer, NULL);
+    if (rc != 0)
+    {
+      sprintf (msg_buf, "Unable to start image writer thread %d", i);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+  }
+
+  if (scen_GetLogFlag ())
+  {
+    scen_Append2Log ();
+    fprintf (scen_GetLogFP (),
+             "%s %u %d image writer threads, %d snapshot buffers\n",
+             __FILE__, __LINE__, num_threads, num_buffers);
+    scen_CloseLog ();
+  }
+#endif
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_MemoryLog
+** PURPOSE:       log memory map to FILE* fp
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  gifq_MemoryLog (FILE * fp)
+{
+  LOG_MEM (fp, &jobs[0], sizeof (gifq_job), GIFQ_MAX_BUFFERS);
+  LOG_MEM (fp, &free_stack[0], sizeof (int), GIFQ_MAX_BUFFERS);
+  LOG_MEM (fp, &ring[0], sizeof (int), GIFQ_MAX_BUFFERS);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_Push
+** PURPOSE:       queue an image for the writer threads
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns TRUE if the image was queued. Returns FALSE when
+**                the queue is not running or every buffer is in use; the
+**                caller must then write the image itself. If an image of
+**                the same name is still queued the queue is drained first.
+**
+*/
+BOOLEAN
+  gifq_Push (GRID_P gif,
+             struct colortable *colortable,
+             char fname[],
+             char date[],
+             int date_color_index)
+{
+#ifdef _MSC_VER
+  return FALSE;
+#else
+  gifq_job *job;
+  int index;
+
+  if (num_threads == 0)
+  {
+    return FALSE;
+  }
+
+  pthread_mutex_lock (&lock);
+  if (gifq_name_in_flight (fname))
+  {
+    while ((num_pending > 0) || (num_busy > 0))
+    {
+      pthread_cond_wait (&idle, &lock);
+    }
+  }
+  if (num_free == 0)
+  {
+    inline_writes++;
+    pthread_mutex_unlock (&lock);
+    return FALSE;
+  }
+  index = free_stack[--num_free];
+  pthread_mutex_unlock (&lock);
+
+  /*
+   *
+   * THE BUFFER BELONGS TO THIS THREAD UNTIL IT IS ON THE RING
+   *
+   */
+  job = &jobs[index];
+  memcpy (job->grid, gif, mem_GetTotalPixels () * sizeof (PIXEL));
+  job->colortable = colortable;
+  strncpy (job->fname, fname, MAX_FILENAME_LEN - 1);
+  job->fname[MAX_FILENAME_LEN - 1] = '\0';
+  strncpy (job->date, date, GIFQ_DATE_LEN - 1);
+  job->date[GIFQ_DATE_LEN - 1] = '\0';
+  job->date_color_index = date_color_index;
+
+  pthread_mutex_lock (&lock);
+  job->in_flight = TRUE;
+  ring[tail] = index;
+  tail = (tail + 1) % num_buffers;
+  num_pending++;
+  pthread_cond_signal (&work_ready);
+  pthread_mutex_unlock (&lock);
+  return TRUE;
+#endif
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_Flush
+** PURPOSE:       wait until every queued image is written
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  gifq_Flush ()
+{
+#ifndef _MSC_VER
+  if (num_threads == 0)
+  {
+    return;
+  }
+  pthread_mutex_lock (&lock);
+  while ((num_pending > 0) || (num_busy > 0))
+  {
+    pthread_cond_wait (&idle, &lock);
+  }
+  pthread_mutex_unlock (&lock);
+#endif
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_Shutdown
+** PURPOSE:       write the queued images and stop the writer threads
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Later images are written by the caller.
+**
+**
+*/
+void
+  gifq_Shutdown ()
+{
+#ifndef _MSC_VER
+  int i;
+
+  if (num_threads == 0)
+  {
+    return;
+  }
+  gifq_Flush ();
+
+  pthread_mutex_lock (&lock);
+  stopping = TRUE;
+  pthread_cond_broadcast (&work_ready);
+  pthread_mutex_unlock (&lock);
+  for (i = 0; i < num_threads; i++)
+  {
+    pthread_join (threads[i], NULL);
+  }
+
+  if (scen_GetLogFlag ())
+  {
+    scen_Append2Log ();
+    fprintf (scen_GetLogFP (),
+             "%s %u %d images written by the caller (queue full)\n",
+             __FILE__, __LINE__, inline_writes);
+    scen_CloseLog ();
+  }
+
+  num_threads = 0;
+  for (i = 0; i < num_buffers; i++)
+  {
+    free (jobs[i].grid);
+    jobs[i].grid = NULL;
+  }
+  num_buffers = 0;
+#endif
+}
+
+#ifndef _MSC_VER
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_writer
+** PURPOSE:       writer thread main loop
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Takes the images off the ring in order and hands them
+**                to gdif_EncodeGIF.
+**
+*/
+static void *
+  gifq_writer (void *arg)
+{
+  gifq_job *job;
+  int index;
+
+  pthread_mutex_lock (&lock);
+  for (;;)
+  {
+    while ((num_pending == 0) && (!stopping))
+    {
+      pthread_cond_wait (&work_ready, &lock);
+    }
+    if (num_pending == 0)
+    {
+      break;
+    }
+    index = ring[head];
+    head = (head + 1) % num_buffers;
+    num_pending--;
+    num_busy++;
+    pthread_mutex_unlock (&lock);
+
+    job = &jobs[index];
+    gdif_EncodeGIF (job->grid,
+                    job->colortable,
+                    job->fname,
+                    job->date,
+                    job->date_color_index);
+
+    pthread_mutex_lock (&lock);
+    job->in_flight = FALSE;
+    free_stack[num_free++] = index;
+    num_busy--;
+    if ((num_pending == 0) && (num_busy == 0))
+    {
+      pthread_cond_broadcast (&idle);
+    }
+  }
+  pthread_mutex_unlock (&lock);
+  return NULL;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: gifq_name_in_flight
+** PURPOSE:       is an image of this name queued or being written
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Called with the lock held.
+**
+**
+*/
+static BOOLEAN
+  gifq_name_in_flight (char fname[])
+{
+  int i;
+
+  for (i = 0; i < num_buffers; i++)
+  {
+    if (jobs[i].in_flight && (strcmp (jobs[i].fname, fname) == 0))
+    {
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+#endif
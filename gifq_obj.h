@@ -0,0 +1,30 @@
+#ifndef GIFQ_OBJ_H
+#define GIFQ_OBJ_H
+#include <stdio.h>
+#include "ugm_defines.h"
+#include "color_obj.h"
+
+/*
+ *
+ * A gifq is the output queue of gdif_WriteGIF. When OUTPUT_WRITER_THREADS
+ * is set, gifq_Push copies the grid into one of a pool of recycled
+ * snapshot buffers and background writer threads map, encode and write
+ * the image. The pool holds at most OUTPUT_QUEUE_MB megabytes
+ * (GIFQ_DEFAULT_QUEUE_MB when unset) and GIFQ_MAX_BUFFERS snapshots;
+ * when every buffer is in use the caller writes the image itself.
+ *
+ */
+#define GIFQ_DEFAULT_QUEUE_MB 64
+#define GIFQ_MAX_BUFFERS 64
+#define GIFQ_DATE_LEN 32
+
+void gifq_Init ();
+void gifq_MemoryLog (FILE * fp);
+BOOLEAN gifq_Push (GRID_P gif,
+                   struct colortable *colortable,
+                   char fname[],
+                   char date[],
+                   int date_color_index);
+void gifq_Flush ();
+void gifq_Shutdown ();
+#endif
@@ -14,6 +14,7 @@ This object encapsulates the basic gird structures.
 #include "ugm_macros.h"
 #include "grid_obj.h"
 #include "memory_obj.h"
+#include "igrid_obj.h"
 
 /*****************************************************************************\
 *******************************************************************************
@@ -109,6 +110,41 @@ void
   }
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: grid_SetStats
+** PURPOSE:       histogram a grid and find its min and max
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   grid_histogram and grid_SetMinMax in one pass: the min
+**                and max are the first and last values of the histogram.
+**                Only touches *grid_ptr, so several grids can be done at
+**                once on separate threads.
+*/
+void
+  grid_SetStats (grid_info * grid_ptr)
+{
+#ifdef PACKING
+  grid_SetMinMax (grid_ptr);
+  grid_histogram (grid_ptr);
+#else
+  int i;
+  int total_pixels;
+
+  grid_histogram (grid_ptr);
+  total_pixels = grid_ptr->nrows * grid_ptr->ncols;
+  if (total_pixels <= 0)
+  {
+    return;
+  }
+  for (i = 0; grid_ptr->histogram[i] == 0; i++);
+  grid_ptr->min = i;
+  for (i = 255; grid_ptr->histogram[i] == 0; i--);
+  grid_ptr->max = i;
+#endif
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: grid_dump
@@ -151,3 +187,23 @@ void
     }
   }
 }
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: grid_SetView
+** PURPOSE:       point a grid_view at a grid of the input size
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   the view is filled once by the caller of a kernel; the
+**                kernel then reads rows, cols and stride from it.
+**
+*/
+void
+  grid_SetView (grid_view * view, GRID_P ptr)
+{
+  view->ptr = ptr;
+  view->nrows = igrid_GetNumRows ();
+  view->ncols = igrid_GetNumCols ();
+  view->stride = view->ncols;
+}
@@ -23,7 +23,22 @@ typedef struct
    year_info year;
 }  grid_info;
 
+/*
+ * a grid_view carries a grid pointer together with its geometry so
+ * the kernels index it without calling back into igrid for the size.
+ * stride is the distance in pixels between two rows.
+ */
+typedef struct
+{
+   GRID_P   ptr;
+   int  nrows;
+   int  ncols;
+   int  stride;
+}  grid_view;
+
 void grid_SetMinMax(grid_info* ptr);
 void grid_dump(FILE* fp,grid_info* grid_ptr);
 void grid_histogram(grid_info * grid_ptr);
+void grid_SetStats(grid_info * grid_ptr);
+void grid_SetView(grid_view* view,GRID_P ptr);
 #endif
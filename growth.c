@@ -54,6 +54,8 @@
 #include "gdif_obj.h"
 #include "timer_obj.h"
 #include "stats_obj.h"
+#include "bgrid_obj.h"
+#include "cgrid_obj.h"
 
 /*****************************************************************************\
 *******************************************************************************
@@ -98,26 +100,21 @@ static void
 cumulate_roads(GRID_P road_state_ptr)
 {
 	char func[] = "cumulate_roads";
-	char command[2 * MAX_FILENAME_LEN + 20];
-	GRID_P workspace;
 	int num_monte_carlo;
 	char road_name[] = "_roads_";
-	char temp_gif_filename[MAX_FILENAME_LEN];
 	char output_gif_filename[MAX_FILENAME_LEN];
-	GRID_P cumulate_road_state;
-	int i;
+	ACCUM_P cumulate_road_state;
+	GRID_P workspace;
 
 	FUNC_INIT;
-	workspace = mem_GetWGridPtr(__FILE__, func, __LINE__);
 	num_monte_carlo = scen_GetMonteCarloIterations();
 
-	assert(workspace != NULL);
 	assert(road_state_ptr != NULL);
-	
-	cumulate_road_state = workspace;
 
 	if (proc_GetProcessingType() != CALIBRATING)
 	{
+		cumulate_road_state = cgrid_GetRoadPtr(proc_GetCurrentYear());
+
 		if (proc_GetCurrentMonteCarlo() == 0)
 		{
 			/*
@@ -126,21 +123,7 @@ cumulate_roads(GRID_P road_state_ptr)
 			 *
 			 */
 
-			util_init_grid(cumulate_road_state, 0);
-		}
-		else
-		{
-			/*
-			 *
-			 * READ IN THE ROAD ACCUMULATION GRID
-			 *
-			 */
-
-			sprintf(temp_gif_filename, "%scumulate_roads.year_%u",
-				scen_GetOutputDir(), proc_GetCurrentYear());
-			inp_slurp(temp_gif_filename,                               /* IN    */
-				cumulate_road_state,                       /* OUT   */
-				memGetBytesPerGridRound());              /* IN    */
+			util_init_accum(cumulate_road_state);
 		}
 
 		/*
@@ -156,13 +139,7 @@ cumulate_roads(GRID_P road_state_ptr)
 			proc_GetCurrentMonteCarlo());
 		util_output_gif_grid(road_state_ptr, output_gif_filename);
 
-		for (i = 0; i < mem_GetTotalPixels(); i++)
-		{
-			if (road_state_ptr[i] > 0)
-			{
-				cumulate_road_state[i]++;
-			}
-		}
+		util_accumulate_positive(road_state_ptr, cumulate_road_state);
 
 		if (proc_GetCurrentMonteCarlo() == num_monte_carlo - 1)
 		{
@@ -171,42 +148,20 @@ cumulate_roads(GRID_P road_state_ptr)
 				* NORMALIZE ACCULUMLATED GRIDS
 				*
 				*/
-			for (i = 0; i < mem_GetTotalPixels(); i++)
-			{
-				cumulate_road_state[i] =
-					255 * cumulate_road_state[i] / num_monte_carlo;
-			}
+			workspace = mem_GetWGridPtr(__FILE__, func, __LINE__);
+			util_normalize_accum(cumulate_road_state, 255, num_monte_carlo,
+				workspace);
 
 			sprintf(output_gif_filename, "%s%s%s%u.gif",
 				scen_GetOutputDir(),
 				igrid_GetLocation(),
 				road_name,
 				proc_GetCurrentYear());
-			util_output_gif_grid(cumulate_road_state, output_gif_filename);
-
-
-			if (proc_GetCurrentMonteCarlo() != 0)
-			{
-				sprintf(command, "rm %s", temp_gif_filename);
-				system(command);
-			}
-		}
-		else
-		{
-			/*
-			 *
-			 * DUMP ACCULUMLATED GRIDS TO DISK
-			 *
-			 */
-			sprintf(temp_gif_filename, "%scumulate_roads.year_%u",
-				scen_GetOutputDir(), proc_GetCurrentYear());
-			out_dump(temp_gif_filename,
-				cumulate_road_state,
-				memGetBytesPerGridRound());
+			util_output_gif_grid(workspace, output_gif_filename);
+			workspace = mem_GetWGridFree(__FILE__, func, __LINE__, workspace);
 		}
 	}
 
-	workspace = mem_GetWGridFree(__FILE__, func, __LINE__, workspace);
 	FUNC_END;
 }
 
@@ -243,16 +198,16 @@ grw_grow(GRID_P z_ptr, GRID_P land1_ptr, GRID_P road_state_ptr)
   int debugcount;
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
   int   i, nrows, ncols;
-  short *zgrwth_row;
-  short *zgrwth_col;
+  COORD_TYPE *zgrwth_row;
+  COORD_TYPE *zgrwth_col;
   int    zgrwth_count;
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
 /* D.D. 8/18/2006 */
   int   row, col, colindex;
-  short *ExcPixRow;
-  short *ExcPixCol;
-  short *UrbPixRow;
-  short *UrbPixCol;
+  COORD_TYPE *ExcPixRow;
+  COORD_TYPE *ExcPixCol;
+  COORD_TYPE *UrbPixRow;
+  COORD_TYPE *UrbPixCol;
 /* D.D. 8/18/2006 */
 
 
@@ -280,14 +235,22 @@ grw_grow(GRID_P z_ptr, GRID_P land1_ptr, GRID_P road_state_ptr)
     proc_SetCurrentYear (igrid_GetUrbanYear (0));
   }
 
+  if (proc_GetProcessingType () != CALIBRATING)
+  {
+    cgrid_Init (proc_GetCurrentYear () + 1, proc_GetStopYear ());
+  }
+
   seed_road_ptr = igrid_GetRoadGridPtrByYear(__FILE__, func, __LINE__, proc_GetCurrentYear());
   pgrid_SetRoadStatePixelCount(igrid_GetIGridRoadPixelCount(proc_GetCurrentYear()));
 
   util_copy_grid(seed_road_ptr, road_state_ptr);
+  spr_BuildRoadNghbrMask(road_state_ptr);
+
+  stats_InitClusters ();
 
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
-  zgrwth_row = (short *)  mem_GetGRZrowptr();
-  zgrwth_col = (short *)  mem_GetGRZcolptr();
+  zgrwth_row = (COORD_TYPE *)  mem_GetGRZrowptr();
+  zgrwth_col = (COORD_TYPE *)  mem_GetGRZcolptr();
   zgrwth_count =          mem_GetGRZcount();
 
   if (zgrwth_count == 0) {util_init_grid (z_ptr, 0);}
@@ -301,6 +264,11 @@ grw_grow(GRID_P z_ptr, GRID_P land1_ptr, GRID_P road_state_ptr)
     }
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
 
+  if (scen_GetPackedUrbanGridFlag ())
+  {
+    bgrid_ClearZ ();
+  }
+
   if (scen_GetDoingLanduseFlag ())
   {
     grw_landuse_init (deltatron_ptr,
@@ -333,6 +301,10 @@ grw_grow(GRID_P z_ptr, GRID_P land1_ptr, GRID_P road_state_ptr)
                if (seed_ptr[OFFSET(row, UrbPixCol[colindex])] > 0)
                   {
                    z_ptr[OFFSET(row, UrbPixCol[colindex])] = PHASE0G;
+                   if (scen_GetPackedUrbanGridFlag ())
+                   {
+                     bgrid_SetZ (row, UrbPixCol[colindex]);
+                   }
                    zgrwth_row[zgrwth_count] = row;
                    zgrwth_col[zgrwth_count] = UrbPixCol[colindex];
                    zgrwth_count++;
@@ -344,6 +316,10 @@ grw_grow(GRID_P z_ptr, GRID_P land1_ptr, GRID_P road_state_ptr)
 
     mem_SetGRZcount(zgrwth_count);
     mem_SetGRZpointer(z_ptr);
+    if (scen_GetUrbanFrontierFlag ())
+    {
+      spr_BuildUrbanFrontier (z_ptr);
+    }
     seed_ptr = igrid_GridRelease (__FILE__, func, __LINE__, seed_ptr);
 
 /** D.D. 8/18/2006 Use the UrbPix array to condition z_ptr more efficiently. **/
@@ -567,8 +543,8 @@ static
   char func[] = "grw_landuse_init";
   int i;
   int total_pixels;
-  GRID_P landuse0_ptr;
-  GRID_P landuse1_ptr;
+  int landuse_index;
+  GRID_P landuse_ptr;
 
 
   FUNC_INIT;
@@ -586,6 +562,7 @@ static
   {
     deltatron_ptr[i] = 0;
   }
+  delta_InitActiveSet ();
   /*
    *
    * IF PREDICTING USE LANDUSE 1 AS THE STARTING LANDUSE
@@ -594,24 +571,17 @@ static
    */
   if (proc_GetProcessingType () == PREDICTING)
   {
-    landuse1_ptr = igrid_GetLanduseGridPtr (__FILE__, func, __LINE__, 1);
-    assert (landuse1_ptr != NULL);
-    for (i = 0; i < total_pixels; i++)
-    {
-      land1_ptr[i] = landuse1_ptr[i];
-    }
-    landuse1_ptr = igrid_GridRelease (__FILE__, func, __LINE__, landuse1_ptr);
+    landuse_index = 1;
   }
   else
   {
-    landuse0_ptr = igrid_GetLanduseGridPtr (__FILE__, func, __LINE__, 0);
-    assert (landuse0_ptr != NULL);
-    for (i = 0; i < total_pixels; i++)
-    {
-      land1_ptr[i] = landuse0_ptr[i];
-    }
-    landuse0_ptr = igrid_GridRelease (__FILE__, func, __LINE__, landuse0_ptr);
+    landuse_index = 0;
   }
+  landuse_ptr = igrid_GetLanduseGridPtr (__FILE__, func, __LINE__,
+                                         landuse_index);
+  assert (landuse_ptr != NULL);
+  delta_InitLand (landuse_ptr, landuse_index, land1_ptr, pgrid_GetLand2Ptr ());
+  landuse_ptr = igrid_GridRelease (__FILE__, func, __LINE__, landuse_ptr);
   FUNC_END;
 }
 
@@ -649,7 +619,6 @@ static
   GRID_P grw_landuse_ws1;
   GRID_P deltatron_ptr;
   GRID_P z_ptr;
-  GRID_P deltatron_workspace1;
   GRID_P slp_ptr;
   GRID_P land2_ptr;
   double *class_slope;
@@ -666,7 +635,6 @@ static
   class_indices = landclass_GetReducedClassesPtr ();
   background_ptr = igrid_GetBackgroundGridPtr (__FILE__, func, __LINE__);
   grw_landuse_ws1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
-  deltatron_workspace1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
   slp_ptr = igrid_GetSlopeGridPtr (__FILE__, func, __LINE__);
   deltatron_ptr = pgrid_GetDeltatronPtr ();
   z_ptr = pgrid_GetZPtr ();
@@ -681,7 +649,6 @@ static
   assert (landuse_classes != NULL);
   assert (class_indices != NULL);
   assert (grw_landuse_ws1 != NULL);
-  assert (deltatron_workspace1 != NULL);
   assert (deltatron_ptr != NULL);
   assert (land1_ptr != NULL);
   assert (land2_ptr != NULL);
@@ -698,32 +665,27 @@ static
      * PLACE THE NEW URBAN SIMULATION INTO THE LAND USE IMAGE
      *
      */
-    util_condition_gif (mem_GetTotalPixels (),
-                        z_ptr,
-                        GT,
-                        0,
-                        land1_ptr,
-                        urban_code);
+    delta_ConditionUrban (z_ptr,
+                          land1_ptr,
+                          land2_ptr,
+                          urban_code);
 
+    /*
+     *
+     * LAND2 EQUALS LAND1 HERE; THE DELTATRON TRANSITIONS LAND2 AND
+     * COPIES THE TRANSITIONED PIXELS BACK INTO LAND1
+     *
+     */
     delta_deltatron (new_indices,                            /* IN     */
                      landuse_classes,                        /* IN     */
                      class_indices,                          /* IN     */
-                     deltatron_workspace1,                   /* MOD    */
                      deltatron_ptr,                          /* IN/OUT */
-                     land1_ptr,                              /* IN     */
-                     land2_ptr,                              /* OUT    */
+                     land1_ptr,                              /* IN/OUT */
+                     land2_ptr,                              /* IN/OUT */
                      slp_ptr,                                /* IN     */
                      num_growth_pix,                         /* IN     */
                      class_slope,                            /* IN     */
                      ftransition);                         /* IN     */
-
-    /*
-     *
-     * SWITCH THE OLD AND THE NEW
-     *
-     */
-    util_copy_grid (land2_ptr,
-                    land1_ptr);
   }
 
   if ((proc_GetProcessingType () == PREDICTING) ||
@@ -754,19 +716,15 @@ static
   if (proc_GetCurrentYear () == landuse1_year)
   {
 
-    util_condition_gif (mem_GetTotalPixels (),
-                        z_ptr,
-                        GT,
-                        0,
-                        land1_ptr,
-                        urban_code);
+    delta_ConditionUrban (z_ptr,
+                          land1_ptr,
+                          land2_ptr,
+                          urban_code);
   }
   background_ptr =
     igrid_GridRelease (__FILE__, func, __LINE__, background_ptr);
   grw_landuse_ws1 =
     mem_GetWGridFree (__FILE__, func, __LINE__, grw_landuse_ws1);
-  deltatron_workspace1 =
-    mem_GetWGridFree (__FILE__, func, __LINE__, deltatron_workspace1);
   slp_ptr = igrid_GridRelease (__FILE__, func, __LINE__, slp_ptr);
   FUNC_END;
 }
@@ -786,29 +744,22 @@ static void
   grw_non_landuse (GRID_P z_ptr)
 {
   char func[] = "grw_non_landuse";
-  char command[2 * MAX_FILENAME_LEN + 20];
-  GRID_P workspace1;
-  GRID_P workspace2;
   int num_monte_carlo;
   char name[] = "_urban_";
-  char gif_filename[MAX_FILENAME_LEN];
-  GRID_P cumulate_monte_carlo;
+  ACCUM_P cumulate_monte_carlo;
+  GRID_P prob;
+  int total_pixels;
   int i;
 
   FUNC_INIT;
-  workspace1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
-  workspace2 = mem_GetWGridPtr (__FILE__, func, __LINE__);
   num_monte_carlo = scen_GetMonteCarloIterations ();
 
-  assert (workspace1 != NULL);
-  assert (workspace2 != NULL);
   assert (z_ptr != NULL);
 
-
-  cumulate_monte_carlo = workspace1;
-
   if (proc_GetProcessingType () != CALIBRATING)
   {
+    cumulate_monte_carlo = cgrid_GetUrbanPtr (proc_GetCurrentYear ());
+
     if (proc_GetCurrentMonteCarlo () == 0)
     {
       /*
@@ -817,44 +768,31 @@ static void
        *
        */
 
-      util_init_grid (cumulate_monte_carlo, 0);
-    }
-    else
-    {
-      /*
-       *
-       * READ IN THE ACCUMULATION GRID
-       *
-       */
-      sprintf (gif_filename, "%scumulate_monte_carlo.year_%u",
-               scen_GetOutputDir (), proc_GetCurrentYear ());
-      inp_slurp (gif_filename,                               /* IN    */
-                 cumulate_monte_carlo,                       /* OUT   */
-                 memGetBytesPerGridRound ());              /* IN    */
+      util_init_accum (cumulate_monte_carlo);
     }
     /*
      *
      * ACCUMULATE Z OVER MONTE CARLOS
      *
      */
-    for (i = 0; i < mem_GetTotalPixels (); i++)
-    {
-      if (z_ptr[i] > 0)
-      {
-        cumulate_monte_carlo[i]++;
-      }
-    }
+    util_accumulate_positive (z_ptr, cumulate_monte_carlo);
 
 
     if (proc_GetCurrentMonteCarlo () == num_monte_carlo - 1)
     {
+      prob = mem_GetWGridPtr (__FILE__, func, __LINE__);
       if (proc_GetProcessingType () == TESTING)
       {
-        util_condition_gif (mem_GetTotalPixels (),           /* IN     */
+        total_pixels = mem_GetTotalPixels ();
+        for (i = 0; i < total_pixels; i++)
+        {
+          prob[i] = (PIXEL) cumulate_monte_carlo[i];
+        }
+        util_condition_gif (total_pixels,                    /* IN     */
                             z_ptr,                           /* IN     */
                             GT,                              /* IN     */
                             0,                               /* IN     */
-                            cumulate_monte_carlo,            /* IN/OUT */
+                            prob,                            /* IN/OUT */
                             100);                          /* IN     */
       }
       else
@@ -865,36 +803,13 @@ static void
          * NORMALIZE ACCULUMLATED GRID
          *
          */
-        for (i = 0; i < mem_GetTotalPixels (); i++)
-        {
-          cumulate_monte_carlo[i] =
-            100 * cumulate_monte_carlo[i] / num_monte_carlo;
-        }
+        util_normalize_accum (cumulate_monte_carlo, 100, num_monte_carlo, prob);
       }
-      util_WriteZProbGrid (cumulate_monte_carlo, name);
-      if (proc_GetCurrentMonteCarlo () != 0)
-      {
-        sprintf (command, "rm %s", gif_filename);
-        system (command);
-      }
-    }
-    else
-    {
-      /*
-       *
-       * DUMP ACCULUMLATED GRID TO DISK
-       *
-       */
-      sprintf (gif_filename, "%scumulate_monte_carlo.year_%u",
-               scen_GetOutputDir (), proc_GetCurrentYear ());
-      out_dump (gif_filename,
-                cumulate_monte_carlo,
-                memGetBytesPerGridRound ());
+      util_WriteZProbGrid (prob, name);
+      prob = mem_GetWGridFree (__FILE__, func, __LINE__, prob);
     }
   }
 
-  workspace1 = mem_GetWGridFree (__FILE__, func, __LINE__, workspace1);
-  workspace2 = mem_GetWGridFree (__FILE__, func, __LINE__, workspace2);
   FUNC_END;
 }
 
@@ -40,6 +40,7 @@ This object encapsulates the management of the input data grids.
 #include <string.h>
 #include <stdio.h>
 #include <errno.h>
+#include <limits.h>
 #ifdef MPI
 #include "mpi.h"
 #endif
@@ -76,8 +77,10 @@ static int road_pixel_count[MAX_ROAD_YEARS];
 static int excld_count;
 static road_percent_t percent_road[MAX_ROAD_YEARS];
 static int total_pixels;
-static short *ExcPixRow, *ExcPixCol;
-static short *UrbPixRow, *UrbPixCol;
+static COORD_TYPE *ExcPixRow, *ExcPixCol;
+static COORD_TYPE *UrbPixRow, *UrbPixCol;
+static COORD_TYPE *SpnPixRow, *SpnPixCol;
+static int SpnPixCount;
 static GRID_P epix;
 static GRID_P upix;
 
@@ -119,6 +122,8 @@ static void igrid_SetLocation ();
 static void igrid_SetFilenames ();
 static void igrid_SetGridSizes (grid_info * grid_ptr);
 static void igrid_ReadGrid (char *filepath, GRID_P scrtch_pad, GRID_P grid_p);
+static void igrid_read_image (GRID_P grid_p, char *filepath);
+static void igrid_BuildSpnPixIndex (void);
 
 /******************************************************************************
 *******************************************************************************
@@ -752,6 +757,7 @@ void
   GRID_P grid_ptr;
   float image_max;
   float norm_factor;
+  PIXEL normalized[256];
 
 #ifdef PACKING
   grid_ptr = mem_GetWGridPtr (__FILE__, func, __LINE__);
@@ -772,10 +778,14 @@ void
 #endif
     image_max = (float) igrid.road[i].max;
     norm_factor = image_max / (float) max_of_max;
+    for (j = 0; j < 256; j++)
+    {
+      normalized[j] = (PIXEL) (((100.0 * j) / image_max) * norm_factor);
+    }
+#pragma omp parallel for
     for (j = 0; j < total_pixels; j++)
     {
-      grid_ptr[j] =
-        (PIXEL) (((100.0 * grid_ptr[j]) / image_max) * norm_factor);
+      grid_ptr[j] = normalized[grid_ptr[j]];
     }
 
   }
@@ -1063,6 +1073,38 @@ static BOOLEAN
   return TRUE;
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: igrid_read_image
+** PURPOSE:       read an input image as GIF or binary PGM
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   the format is taken from the file's magic number, as in
+**                igrid_SetGridSizes.
+**
+*/
+static void
+  igrid_read_image (GRID_P grid_p, char *filepath)
+{
+  char func[] = "igrid_read_image";
+  FILE *fp;
+  char magic[2];
+  size_t nread;
+
+  FILE_OPEN (fp, filepath, "rb");
+  nread = fread (magic, 1, 2, fp);
+  fclose (fp);
+  if ((nread == 2) && (magic[0] == 'P') && (magic[1] == '5'))
+  {
+    gdif_ReadPGM (grid_p, filepath);
+  }
+  else
+  {
+    gdif_ReadGIF (grid_p, filepath);
+  }
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: igrid_ReadGrid
@@ -1087,7 +1129,7 @@ static void
   {
     if (glb_mype == 0)
     {
-      gdif_ReadGIF (scratch_pad, filepath);
+      igrid_read_image (scratch_pad, filepath);
     }
 #ifdef MPI
     MPI_Bcast (scratch_pad, memGetBytesPerGridRound (),
@@ -1113,7 +1155,7 @@ static void
   {
     if (glb_mype == 0)
     {
-      gdif_ReadGIF (grid_ptr, filepath);
+      igrid_read_image (grid_ptr, filepath);
     }
 #ifdef MPI
     MPI_Bcast (grid_ptr, memGetBytesPerGridRound (),
@@ -1145,6 +1187,8 @@ void
 {
   char func[] = "igrid_ReadFiles";
   int i;
+  int num_grids;
+  grid_info *grids[MAX_URBAN_YEARS + MAX_ROAD_YEARS + MAX_LANDUSE_YEARS + 3];
   GRID_P scratch_pad = NULL;
 #ifdef PACKING
   scratch_pad = mem_GetWGridPtr (__FILE__, func, __LINE__);
@@ -1152,13 +1196,13 @@ void
 #endif
 
 
+  num_grids = 0;
   for (i = 0; i < igrid.urban_count; i++)
   {
     igrid.urban[i].ptr = mem_GetIGridPtr (func);
     igrid_ReadGrid (igrid.urban[i].filename,
                     scratch_pad, igrid.urban[i].ptr);
-    grid_SetMinMax (&igrid.urban[i]);
-    grid_histogram (&igrid.urban[i]);
+    grids[num_grids++] = &igrid.urban[i];
   }
 
   for (i = 0; i < igrid.road_count; i++)
@@ -1166,8 +1210,7 @@ void
     igrid.road[i].ptr = mem_GetIGridPtr (func);
     igrid_ReadGrid (igrid.road[i].filename,
                     scratch_pad, igrid.road[i].ptr);
-    grid_SetMinMax (&igrid.road[i]);
-    grid_histogram (&igrid.road[i]);
+    grids[num_grids++] = &igrid.road[i];
   }
 
   for (i = 0; i < igrid.landuse_count; i++)
@@ -1175,32 +1218,42 @@ void
     igrid.landuse[i].ptr = mem_GetIGridPtr (func);
     igrid_ReadGrid (igrid.landuse[i].filename,
                     scratch_pad, igrid.landuse[i].ptr);
-    grid_SetMinMax (&igrid.landuse[i]);
-    grid_histogram (&igrid.landuse[i]);
+    grids[num_grids++] = &igrid.landuse[i];
   }
 
   igrid.excluded.ptr = mem_GetIGridPtr (func);
   igrid_ReadGrid (igrid.excluded.filename,
                   scratch_pad, igrid.excluded.ptr);
-  grid_SetMinMax (&igrid.excluded);
-  grid_histogram (&igrid.excluded);
+  grids[num_grids++] = &igrid.excluded;
 
   igrid.slope.ptr = mem_GetIGridPtr (func);
   igrid_ReadGrid (igrid.slope.filename,
                   scratch_pad, igrid.slope.ptr);
-  grid_SetMinMax (&igrid.slope);
-  grid_histogram (&igrid.slope);
+  grids[num_grids++] = &igrid.slope;
 
   igrid.background.ptr = mem_GetIGridPtr (func);
   igrid_ReadGrid (igrid.background.filename,
                   scratch_pad, igrid.background.ptr);
-  grid_SetMinMax (&igrid.background);
-  grid_histogram (&igrid.excluded);
+  grids[num_grids++] = &igrid.background;
 
 #ifdef PACKING
   scratch_pad = mem_GetWGridFree (__FILE__, func, __LINE__, scratch_pad);
 #endif
 
+  /*
+   *
+   * the grids are read one at a time (GD decodes with static state), then
+   * histogrammed together (OpenMP threads when built with -fopenmp)
+   *
+   */
+#ifndef PACKING
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (i = 0; i < num_grids; i++)
+  {
+    grid_SetStats (grids[i]);
+  }
+
   igrid_CountRoadPixels ();
   igrid_CalculatePercentRoads ();
 }
@@ -1408,6 +1461,7 @@ static void
 {
 #define BYTES2READ 15
 #define GIF_ID "GIF"
+#define PGM_ID "P5"
 #define GIF_ROW_OFFSET 8
 #define GIF_COL_OFFSET 6
 #define GIF_RES_OFFSET 10
@@ -1422,7 +1476,9 @@ static void
   int bits_per_pixel;
   int color_bits;
 
-
+  memset (buffer, 0, sizeof (buffer));
+  nrows = 0;
+  ncols = 0;
   if (glb_mype == 0)
   {
     FILE_OPEN (fp, grid_ptr->filename, "rb");
@@ -1434,19 +1490,55 @@ static void
 #endif
 
 
-  strncpy (id_str, (char *) buffer, strlen (GIF_ID));
-  if (strncmp (GIF_ID, id_str, strlen (GIF_ID)) != 0)
+  /*
+   * binary PGM inputs carry no 16 bit size limit; they are read as
+   * 8 bit gray grids
+   */
+  if (strncmp (PGM_ID, (char *) buffer, strlen (PGM_ID)) == 0)
+  {
+    if (glb_mype == 0)
+    {
+      if (!gdif_ReadPGMSize (grid_ptr->filename, &nrows, &ncols))
+      {
+        printf ("\n\n%s %d file: %s is not a valid %s format\n",
+                __FILE__, __LINE__, grid_ptr->filename, "PGM");
+        EXIT (1);
+      }
+    }
+#ifdef MPI
+    MPI_Bcast (&nrows, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Bcast (&ncols, 1, MPI_INT, 0, MPI_COMM_WORLD);
+#endif
+    color_bits = 8;
+    bits_per_pixel = 8;
+  }
+  else
+  {
+    strncpy (id_str, (char *) buffer, strlen (GIF_ID));
+    if (strncmp (GIF_ID, id_str, strlen (GIF_ID)) != 0)
+    {
+      printf ("\n\n%s %d file: %s is not a %s format\n",
+              __FILE__, __LINE__, grid_ptr->filename, GIF_ID);
+      EXIT (1);
+    }
+    ncols = CONVERT2UINT (buffer[GIF_COL_OFFSET], buffer[GIF_COL_OFFSET + 1]);
+    nrows = CONVERT2UINT (buffer[GIF_ROW_OFFSET], buffer[GIF_ROW_OFFSET + 1]);
+    resolution = (int) buffer[GIF_RES_OFFSET];
+    color_bits = (((resolution & 112) >> 4) + 1);
+    bits_per_pixel = (resolution & 7) + 1;
+  }
+
+  /*
+   * total_pixels is an int; reject the grid before the product
+   * overflows it
+   */
+  if ((double) nrows * (double) ncols > (double) INT_MAX)
   {
-    printf ("\n\n%s %d file: %s is not a %s format\n",
-            __FILE__, __LINE__, grid_ptr->filename, GIF_ID);
+    printf ("\n\n%s %d file: %s has %d x %d pixels, more than %d\n",
+            __FILE__, __LINE__, grid_ptr->filename, nrows, ncols, INT_MAX);
     EXIT (1);
   }
-  ncols = CONVERT2UINT (buffer[GIF_COL_OFFSET], buffer[GIF_COL_OFFSET + 1]);
-  nrows = CONVERT2UINT (buffer[GIF_ROW_OFFSET], buffer[GIF_ROW_OFFSET + 1]);
   total_pixels = nrows * ncols;
-  resolution = (int) buffer[GIF_RES_OFFSET];
-  color_bits = (((resolution & 112) >> 4) + 1);
-  bits_per_pixel = (resolution & 7) + 1;
   grid_ptr->ncols = ncols;
   grid_ptr->nrows = nrows;
   grid_ptr->color_bits = color_bits;
@@ -1685,7 +1777,9 @@ static void
   igrid_CountRoadPixels ()
 {
   char func[] = "igrid_CountRoadPixel";
+#ifdef PACKING
   GRID_P roads;
+#endif
   int i;
 
   assert (total_pixels > 0);
@@ -1698,15 +1792,14 @@ static void
              roads,
              total_pixels,
              -1);
-#else
-    roads = igrid.road[i].ptr;
-#endif
     road_pixel_count[i] = util_count_pixels (total_pixels,
                                              roads,
                                              GT,
                                              0);
-#ifdef PACKING
     mem_GetWGridFree (__FILE__, func, __LINE__, roads);
+#else
+    /* the pixels > 0, from the histogram of the raw road grid */
+    road_pixel_count[i] = total_pixels - igrid.road[i].histogram[0];
 #endif
   }
 }
@@ -1726,7 +1819,9 @@ static void
   igrid_CalculatePercentRoads ()
 {
   char func[] = "igrid_CalculatePercentRoads";
+#ifdef PACKING
   GRID_P excld;
+#endif
   int i;
 
 
@@ -1737,13 +1832,18 @@ static void
            excld,
            total_pixels,
            -1);
-#else
-  excld = igrid.excluded.ptr;
-#endif
   excld_count = util_count_pixels (total_pixels,
                                    excld,
                                    GE,
                                    100);
+#else
+  /* the pixels >= 100, from the histogram of the excluded grid */
+  excld_count = 0;
+  for (i = 100; i < 256; i++)
+  {
+    excld_count += igrid.excluded.histogram[i];
+  }
+#endif
   if (total_pixels - excld_count <= 0)
   {
     sprintf (msg_buf, "mem_GetTotalPixels()=%d excld_count = %d\n",
@@ -1863,8 +1963,14 @@ static void
 {
   char path[MAX_FILENAME_LEN];
   char date_str[] = "";
+  int len;
 
   sprintf (path, "%secho_of_%s", scen_GetOutputDir (), filename);
+  len = strlen (path);
+  if ((len > 4) && (strcmp (&path[len - 4], ".pgm") == 0))
+  {
+    strcpy (&path[len - 4], ".gif");
+  }
   gdif_WriteGIF (ptr,
                  color_GetColortable (GRAYSCALE_COLORTABLE),
                  path,
@@ -1888,14 +1994,14 @@ int
 {
  char func[] = "igrid_BuildCompactExcPixFile";
  int   length, i, j, k;
- short nrows, ncols;
+ int nrows, ncols;
 
  nrows = igrid_GetNumRows();
  ncols = igrid_GetNumCols();
  length = igrid_GetIGridExcludedPixelCount();
  if (length < 200) length = 200000;
- ExcPixRow = malloc( (nrows+2) * sizeof(short));
- ExcPixCol = malloc( (length+2) * sizeof(short));
+ ExcPixRow = malloc( (nrows+2) * sizeof(COORD_TYPE));
+ ExcPixCol = malloc( (length+2) * sizeof(COORD_TYPE));
 
   if ( (ExcPixRow == NULL) || (ExcPixCol == NULL) )
   {
@@ -1920,9 +2026,77 @@ int
       }
    }
 
+ if (scen_GetSpontaneousSamplingFlag ())
+   {
+    igrid_BuildSpnPixIndex();
+   }
+
  return(0);
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: igrid_BuildSpnPixIndex
+** PURPOSE:       Build the index of candidate pixels for spontaneous growth.
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   A candidate is an interior pixel which can pass both the
+**                exclusion test (excluded value below 99) and the slope
+**                test (slope below the critical slope, whose weight is
+**                1.0 whatever the slope resistance). Pixels outside the
+**                index can never be urbanized by spontaneous growth.
+**
+*/
+static void
+  igrid_BuildSpnPixIndex(void)
+{
+ char func[] = "igrid_BuildSpnPixIndex";
+ int   i, j;
+ int   nrows, ncols;
+ GRID_P slp;
+
+ nrows = igrid_GetNumRows();
+ ncols = igrid_GetNumCols();
+ slp = igrid_GetSlopeGridPtr (__FILE__, func, __LINE__);
+
+ SpnPixCount = 0;
+ for (i=1; i<nrows-1; i++)
+   {
+    for (j=1; j<ncols-1; j++)
+      {
+       if ((epix[OFFSET(i,j)] < 99) && (slp[OFFSET(i,j)] < scen_GetCriticalSlope ()))
+         {
+          SpnPixCount++;
+         }
+      }
+   }
+
+ SpnPixRow = malloc( (SpnPixCount+1) * sizeof(COORD_TYPE));
+ SpnPixCol = malloc( (SpnPixCount+1) * sizeof(COORD_TYPE));
+ if ( (SpnPixRow == NULL) || (SpnPixCol == NULL) )
+  {
+    LOG_ERROR ("Unable to allocate memory for SpnPix");
+    EXIT (1);
+  }
+
+ SpnPixCount = 0;
+ for (i=1; i<nrows-1; i++)
+   {
+    for (j=1; j<ncols-1; j++)
+      {
+       if ((epix[OFFSET(i,j)] < 99) && (slp[OFFSET(i,j)] < scen_GetCriticalSlope ()))
+         {
+          SpnPixRow[SpnPixCount] = i;
+          SpnPixCol[SpnPixCount] = j;
+          SpnPixCount++;
+         }
+      }
+   }
+
+ slp = igrid_GridRelease (__FILE__, func, __LINE__, slp);
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: igrid_BuildCompactUrbPixFile
@@ -1939,7 +2113,7 @@ int
 {
  char func[] = "igrid_BuildCompactUrbPixFile";
  int   length, i, j, k;
- short nrows, ncols;
+ int nrows, ncols;
 
  nrows = igrid_GetNumRows();
  ncols = igrid_GetNumCols();
@@ -1948,8 +2122,8 @@ int
  for (i=1; i<256; i++) {length+=igrid.urban[0].histogram[i];}
  if (length < 200) length = 200000;
 
- UrbPixRow = malloc( (nrows+2) * sizeof(short));
- UrbPixCol = malloc( (length+2) * sizeof(short));
+ UrbPixRow = malloc( (nrows+2) * sizeof(COORD_TYPE));
+ UrbPixCol = malloc( (length+2) * sizeof(COORD_TYPE));
 
  upix = igrid_GetUrbanGridPtr (__FILE__, func, __LINE__, 0);
 
@@ -1981,7 +2155,7 @@ int
 **                
 **                
 */
-short*
+COORD_TYPE*
   igrid_GetExcPixRowPtr()
 {
   return ExcPixRow ;
@@ -1998,12 +2172,63 @@ short*
 **                
 **                
 */
-short*
+COORD_TYPE*
   igrid_GetExcPixColPtr()
 {
   return ExcPixCol ;
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: igrid_GetSpnPixRowPtr
+** PURPOSE:       Return a pointer to the spontaneous-candidate row array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   
+**                
+**                
+*/
+COORD_TYPE*
+  igrid_GetSpnPixRowPtr()
+{
+  return SpnPixRow ;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: igrid_GetSpnPixColPtr
+** PURPOSE:       Return a pointer to the spontaneous-candidate column array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   
+**                
+**                
+*/
+COORD_TYPE*
+  igrid_GetSpnPixColPtr()
+{
+  return SpnPixCol ;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: igrid_GetSpnPixCount
+** PURPOSE:       Return the number of spontaneous-candidate pixels
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   
+**                
+**                
+*/
+int
+  igrid_GetSpnPixCount()
+{
+  return SpnPixCount ;
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: igrid_GetUrbPixRowPtr
@@ -2015,7 +2240,7 @@ short*
 **                
 **                
 */
-short*
+COORD_TYPE*
   igrid_GetUrbPixRowPtr()
 {
   return UrbPixRow ;
@@ -2032,7 +2257,7 @@ short*
 **                
 **                
 */
-short*
+COORD_TYPE*
   igrid_GetUrbPixColPtr()
 {
   return UrbPixCol ;
@@ -84,13 +84,17 @@ int  igrid_BuildCompactUrbPixFile(void);
 /* D.D. Added August 16, 2006 */
 
 /* D.D. Added August 18, 2006 */
-short* igrid_GetExcPixRowPtr();
-short* igrid_GetExcPixColPtr();
-short* igrid_GetUrbPixRowPtr();
-short* igrid_GetUrbPixColPtr();
+COORD_TYPE* igrid_GetExcPixRowPtr();
+COORD_TYPE* igrid_GetExcPixColPtr();
+COORD_TYPE* igrid_GetUrbPixRowPtr();
+COORD_TYPE* igrid_GetUrbPixColPtr();
 GRID_P igrid_GetUrbPixPointer();
 
 /* D.D. Added August 18, 2006 */
 
+COORD_TYPE* igrid_GetSpnPixRowPtr();
+COORD_TYPE* igrid_GetSpnPixColPtr();
+int    igrid_GetSpnPixCount();
+
 #endif
 
@@ -45,7 +45,7 @@ static int num_landclasses;
 static char filename[MAX_FILENAME_LEN];
 static int max_landclass_num;
 static int num_reduced_classes;
-static char annual_prob_filename[MAX_FILENAME_LEN];
+static ACCUM_P annual_prob;
 static BOOLEAN ugm_read;
 
 /*****************************************************************************\
@@ -83,7 +83,7 @@ void
   LOG_MEM_CHAR_ARRAY (fp, &filename, sizeof (char), MAX_FILENAME_LEN);
   LOG_MEM (fp, &max_landclass_num, sizeof (int), 1);
   LOG_MEM (fp, &num_reduced_classes, sizeof (int), 1);
-  LOG_MEM_CHAR_ARRAY (fp, &annual_prob_filename, sizeof (char), MAX_FILENAME_LEN);
+  LOG_MEM (fp, &annual_prob, sizeof (ACCUM_P), 1);
   LOG_MEM (fp, &ugm_read, sizeof (int), 1);
 }
 
@@ -414,157 +414,99 @@ BOOLEAN
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: landclass_AnnualProbInit
-** PURPOSE:       initializes the annual_class_probabilities file with 0's
+** PURPOSE:       initializes the annual class histogram with 0's
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   The histogram holds, for every pixel, the count of Monte
+**                Carlo iterations ending in each land class. It is
+**                allocated on the first call and kept for later runs.
 **
 */
 void
   landclass_AnnualProbInit ()
 {
   char func[] = "landclass_AnnualProbInit";
-  FILE *fp;
-  int i;
-  int num_pixels;
-  int num_written;
-  int zero = 0;
+  size_t num_bytes;
 
-  sprintf (annual_prob_filename, "%sannual_class_probabilities_%u",
-           scen_GetOutputDir (), glb_mype);
+  num_bytes = (size_t) mem_GetTotalPixels () *
+    landclass_GetNumLandclasses () * sizeof (ACCUM_TYPE);
 
-  FILE_OPEN (fp, annual_prob_filename, "wb");
-
-  num_pixels = mem_GetTotalPixels () * landclass_GetNumLandclasses ();
-  for (i = 0; i < num_pixels; i++)
+  if (annual_prob == NULL)
   {
-    num_written = fwrite (&zero, sizeof (PIXEL), 1, fp);
-    if (num_written != 1)
+    annual_prob = malloc (num_bytes);
+    if (annual_prob == NULL)
     {
-      sprintf (msg_buf, "Unable to write to file: %s", annual_prob_filename);
-      LOG_ERROR (msg_buf);
-      sprintf (msg_buf, "%s", strerror (errno));
+      sprintf (msg_buf, "Unable to allocate %llu bytes of memory",
+               (unsigned long long) num_bytes);
       LOG_ERROR (msg_buf);
       EXIT (1);
     }
   }
+  memset (annual_prob, 0, num_bytes);
+
   if (scen_GetLogFlag ())
   {
     scen_Append2Log ();
     if (scen_GetLogWritesFlag ())
     {
-      fprintf (scen_GetLogFP (), "%s %u %u zeroes written to %s\n",
-               __FILE__, __LINE__, num_pixels, annual_prob_filename);
+      fprintf (scen_GetLogFP (), "%s %u %llu bytes of annual class counts\n",
+               __FILE__, __LINE__, (unsigned long long) num_bytes);
     }
     scen_CloseLog ();
   }
-  fclose (fp);
-
 }
 
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: landclass_AnnualProbUpdate
-** PURPOSE:       update the annual_prob_filename
+** PURPOSE:       update the annual class histogram
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   Counts the land class of every pixel in a single pass.
 **
 */
 void
   landclass_AnnualProbUpdate (GRID_P land1_ptr)
 {
-  char func[] = "landclass_AnnualProbUpdate";
-  FILE *fp;
   int total_pixels;
+  int num_classes;
   int i;
   int cc;
-  int rc;
-  int offset;
-  fpos_t pos_ptr;
-  GRID_P current_class_ptr;
+  ACCUM_P histogram;
 
   if (!scen_GetDoingLanduseFlag ())
   {
     return;
   }
 
-  current_class_ptr = mem_GetWGridPtr (__FILE__, func, __LINE__);
   total_pixels = mem_GetTotalPixels ();
-  if (scen_GetLogFlag ())
-  {
-    scen_Append2Log ();
-    if (scen_GetLogWritesFlag ())
-    {
-      fprintf (scen_GetLogFP (), "%s %u updating file %s\n",
-               __FILE__, __LINE__, annual_prob_filename);
-    }
-    scen_CloseLog ();
-  }
-
-  FILE_OPEN (fp, annual_prob_filename, "r+b");
+  num_classes = landclass_GetNumLandclasses ();
+  histogram = annual_prob;
+  assert (histogram != NULL);
 
-  for (cc = 0; cc < landclass_GetNumLandclasses (); cc++)
+  for (i = 0; i < total_pixels; i++)
   {
-    offset = cc * total_pixels * sizeof (PIXEL);
-    rc = fseek (fp, offset, SEEK_SET);
-    if (rc != 0)
-    {
-      printf ("%s %u ERROR\n", __FILE__, __LINE__);
-      EXIT (1);
-    }
-    rc = fgetpos (fp, &pos_ptr);
-    if (rc != 0)
-    {
-      printf ("%s %u ERROR\n", __FILE__, __LINE__);
-      EXIT (1);
-    }
-    rc = fread (current_class_ptr, total_pixels * sizeof (PIXEL), 1, fp);
-    if (feof (fp) || ferror (fp))
+    cc = new_indices[land1_ptr[i]];
+    if ((cc >= 0) && (cc < num_classes))
     {
-      printf ("%s %u ERROR\n", __FILE__, __LINE__);
-      EXIT (1);
-    }
-    for (i = 0; i < total_pixels; i++)
-    {
-      if (cc == new_indices[land1_ptr[i]])
-      {
-        (current_class_ptr[i])++;
-      }
-    }
-    rc = fsetpos (fp, &pos_ptr);
-    if (rc != 0)
-    {
-      printf ("%s %u ERROR\n", __FILE__, __LINE__);
-      EXIT (1);
-    }
-    rc = fwrite (current_class_ptr, total_pixels * sizeof (PIXEL), 1, fp);
-    if (rc != 1)
-    {
-      printf ("%s %u ERROR\n", __FILE__, __LINE__);
-      EXIT (1);
+      histogram[cc]++;
     }
+    histogram += num_classes;
   }
-  fclose (fp);
-  current_class_ptr = mem_GetWGridFree (__FILE__,
-                                        func,
-                                        __LINE__,
-                                        current_class_ptr);
 }
 
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: landclass_BuildProbImage
-** PURPOSE:       build prob images from annual_prob_filename
+** PURPOSE:       build prob images from the annual class histogram
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   cum_probability_ptr gets the first most frequent class
+**                of each pixel (it is left as is when that is class 0) and
+**                cum_uncertainty_ptr the share of the other classes.
 **
 */
 void
@@ -572,123 +514,61 @@ void
                             GRID_P cum_uncertainty_ptr)
 {
   char func[] = "landclass_BuildProbImage";
-  char command[2 * MAX_FILENAME_LEN + 20];
   int total_pixels;
-  GRID_P max_grid;
-  GRID_P sum_grid;
-  GRID_P inp_grid;
+  ACCUM_P histogram;
+  ACCUM_TYPE max_count;
+  long long sum_count;
   int num_landclasses;
   int i;
   int k;
-  FILE *fp;
 
   num_landclasses = landclass_GetNumLandclasses ();
   total_pixels = mem_GetTotalPixels ();
 
-  max_grid = mem_GetWGridPtr (__FILE__, func, __LINE__);
-  sum_grid = mem_GetWGridPtr (__FILE__, func, __LINE__);
-  inp_grid = mem_GetWGridPtr (__FILE__, func, __LINE__);
-  assert (sum_grid != NULL);
-  assert (max_grid != NULL);
-  assert (inp_grid != NULL);
+  assert (annual_prob != NULL);
   assert (cum_probability_ptr != NULL);
   assert (cum_uncertainty_ptr != NULL);
   assert (num_landclasses > 0);
   assert (total_pixels > 0);
 
-  if (scen_GetLogFlag ())
-  {
-    scen_Append2Log ();
-    if (scen_GetLogReadsFlag ())
-    {
-      fprintf (scen_GetLogFP (), "%s %u Reading file: %s\n",
-               __FILE__, __LINE__, annual_prob_filename);
-    }
-    scen_CloseLog ();
-  }
-
-  FILE_OPEN (fp, annual_prob_filename, "rb");
-
-  /*
-   *
-   * READ IN THE K=0 LANDCLASS DATA
-   *
-   */
-  fread (max_grid, sizeof (PIXEL), total_pixels, fp);
-  if (feof (fp) || ferror (fp))
-  {
-    sprintf (msg_buf, "reading file: %s", annual_prob_filename);
-    LOG_ERROR (msg_buf);
-    sprintf (msg_buf, "%s", strerror (errno));
-    LOG_ERROR (msg_buf);
-    EXIT (1);
-  }
-
-  /*
-   *
-   * INITIALIZE SUM_GRID
-   *
-   */
-  memcpy (sum_grid, max_grid, sizeof (PIXEL) * total_pixels);
-
-  for (k = 1; k < num_landclasses; k++)
+  histogram = annual_prob;
+  for (i = 0; i < total_pixels; i++)
   {
     /*
      *
-     * READ IN THE K=0 LANDCLASS DATA
+     * LOOK FOR THE MAX AND THE SUM OF THE CLASS COUNTS
      *
      */
-    fread (inp_grid, sizeof (PIXEL), total_pixels, fp);
-    if (feof (fp) || ferror (fp))
+    max_count = histogram[0];
+    sum_count = histogram[0];
+    for (k = 1; k < num_landclasses; k++)
     {
-      sprintf (msg_buf, "reading file: %s", annual_prob_filename);
-      LOG_ERROR (msg_buf);
-      sprintf (msg_buf, "%s", strerror (errno));
-      LOG_ERROR (msg_buf);
-      EXIT (1);
+      if (histogram[k] > max_count)
+      {
+        max_count = histogram[k];
+        cum_probability_ptr[i] = k;
+      }
+      sum_count += histogram[k];
     }
+    histogram += num_landclasses;
 
     /*
      *
-     * NOW LOOK FOR THE MAX OF THE MAX AND THE SUM
+     * CALCULATE THE CUM_UNCERTAINTY GRID
      *
      */
-    for (i = 0; i < total_pixels; i++)
-    {
-      if (inp_grid[i] > max_grid[i])
-      {
-        max_grid[i] = inp_grid[i];
-        cum_probability_ptr[i] = k;
-      }
-      sum_grid[i] += inp_grid[i];
-    }
-  }
-  fclose (fp);
-  sprintf (command, "rm %s", annual_prob_filename);
-  system (command);
-
-
-  /*
-   *
-   * CALCULATE THE CUM_UNCERTAINTY GRID
-   *
-   */
-  for (i = 0; i < total_pixels; i++)
-  {
-    if (sum_grid[i] != 0)
+    if (sum_count != 0)
     {
-      cum_uncertainty_ptr[i] = 100 - (100 * max_grid[i]) / sum_grid[i];
+      cum_uncertainty_ptr[i] = 100 - (int) ((100 * (long long) max_count) /
+                                            sum_count);
     }
     else
     {
-      sprintf (msg_buf, "divide by zero: sum_grid[%u] = %d", i, sum_grid[i]);
+      sprintf (msg_buf, "divide by zero: sum_grid[%u] = %d", i, 0);
       LOG_ERROR (msg_buf);
       EXIT (1);
     }
   }
-  max_grid = mem_GetWGridFree (__FILE__, func, __LINE__, max_grid);
-  sum_grid = mem_GetWGridFree (__FILE__, func, __LINE__, sum_grid);
-  inp_grid = mem_GetWGridFree (__FILE__, func, __LINE__, inp_grid);
 }
 
 /******************************************************************************
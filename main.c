@@ -114,6 +114,11 @@
 #include "timer_obj.h"
 #include "landclass_obj.h"
 #include "pgrid_obj.h"
+#include "bgrid_obj.h"
+#include "egrid_obj.h"
+#include "cgrid_obj.h"
+#include "gifq_obj.h"
+#include "rstore_obj.h"
 #include "color_obj.h"
 #include "memory_obj.h"
 #include "color_obj.h"
@@ -254,7 +259,9 @@ int
   timer_Init ();
   timer_Start (TOTAL_TIME);
 
+#if !defined(CALL_STACK_RING) && !defined(CALL_STACK_OFF)
   glb_call_stack_index = -1;
+#endif
   FUNC_INIT;
 
   /*
@@ -539,6 +546,11 @@ printf("\nIN MAIN - FINISHED MEM INITIALIZATION\n");
     timer_MemoryLog (mem_GetLogFP ());
     igrid_MemoryLog (mem_GetLogFP ());
     pgrid_MemoryLog (mem_GetLogFP ());
+    bgrid_MemoryLog (mem_GetLogFP ());
+    egrid_MemoryLog (mem_GetLogFP ());
+    cgrid_MemoryLog (mem_GetLogFP ());
+    gifq_MemoryLog (mem_GetLogFP ());
+    rstore_MemoryLog (mem_GetLogFP ());
     stats_MemoryLog (mem_GetLogFP ());
     mem_MemoryLog (mem_GetLogFP ());
     proc_MemoryLog (mem_GetLogFP ());
@@ -584,6 +596,34 @@ printf("\nIN MAIN - FINISHED MEM INITIALIZATION\n");
    */
   pgrid_Init ();
 
+  /*
+   *
+   * INITIALIZE THE PACKED URBAN GRIDS (IF REQUESTED)
+   *
+   */
+  bgrid_Init ();
+
+  /*
+   *
+   * INITIALIZE THE BIT-SLICED ENSEMBLE GRIDS (IF REQUESTED)
+   *
+   */
+  egrid_Init ();
+
+  /*
+   *
+   * START THE IMAGE WRITER THREADS (IF REQUESTED)
+   *
+   */
+  gifq_Init ();
+
+  /*
+   *
+   * OPEN THE RESULTS STORE SEGMENT OF THIS PROCESS (IF REQUESTED)
+   *
+   */
+  rstore_Init ();
+
   if (scen_GetLogFlag ())
   {
     if (scen_GetLogColortablesFlag ())
@@ -663,7 +703,8 @@ printf("\nIN MAIN - FINISHED MEM INITIALIZATION\n");
   }
 
   proc_SetNumRunsExecThisCPU (0);
-  if (proc_GetCurrentRun () == 0 && glb_mype == 0)
+  if (proc_GetCurrentRun () == 0 && glb_mype == 0 &&
+      !scen_GetWriteResultsStoreFlag ())
   {
     if (proc_GetProcessingType () != PREDICTING)
     {
@@ -820,20 +861,29 @@ printf("\nIN MAIN - FINISHED MEM INITIALIZATION\n");
               proc_IncrementCurrentRun ();
               if (proc_GetProcessingType () == TESTING)
               {
-                stats_ConcatenateControlFiles ();
-                if (scen_GetWriteCoeffFileFlag ())
+                if (scen_GetWriteResultsStoreFlag ())
                 {
-                  coeff_ConcatenateFiles ();
+                  rstore_Close ();
+                  rstore_MergeIndex ();
                 }
-                if (scen_GetWriteAvgFileFlag ())
+                else
                 {
-                  stats_ConcatenateAvgFiles ();
-                }
-                if (scen_GetWriteStdDevFileFlag ())
-                {
-                  stats_ConcatenateStdDevFiles ();
+                  stats_ConcatenateControlFiles ();
+                  if (scen_GetWriteCoeffFileFlag ())
+                  {
+                    coeff_ConcatenateFiles ();
+                  }
+                  if (scen_GetWriteAvgFileFlag ())
+                  {
+                    stats_ConcatenateAvgFiles ();
+                  }
+                  if (scen_GetWriteStdDevFileFlag ())
+                  {
+                    stats_ConcatenateStdDevFiles ();
+                  }
                 }
 
+                gifq_Shutdown ();
                 timer_Stop (TOTAL_TIME);
                 if (scen_GetLogFlag ())
                 {
@@ -854,6 +904,14 @@ printf("\nIN MAIN - FINISHED MEM INITIALIZATION\n");
     }
   }
 
+  /*
+   *
+   * WAIT FOR THE QUEUED IMAGES AND CLOSE THE RESULTS STORE SEGMENT
+   *
+   */
+  gifq_Shutdown ();
+  rstore_Close ();
+
 #ifdef MPI
   MPI_Barrier (MPI_COMM_WORLD);
 #endif
@@ -902,7 +960,11 @@ if (glb_mype == 0)
 /***************************************************/
 
 
-  if (glb_mype == 0)
+  if ((glb_mype == 0) && scen_GetWriteResultsStoreFlag ())
+  {
+    rstore_MergeIndex ();
+  }
+  else if (glb_mype == 0)
   {
     if (scen_GetWriteCoeffFileFlag ())
     {
@@ -1040,7 +1102,6 @@ static void
 void
   catch (int signo)
 {
-  int i;
   if (tracer < 2)
   {
     printf ("%s %u pe: %u %s\n", __FILE__, __LINE__, glb_mype,
@@ -1060,48 +1121,28 @@ void
   {
     printf ("%s %u caught signo SIGBUS : bus error\n",
             __FILE__, __LINE__);
-    printf ("Currently executing function: %s\n",
-            glb_call_stack[glb_call_stack_index]);
-    for (i = glb_call_stack_index; i >= 0; i--)
-    {
-      printf ("glb_call_stack[%d]= %s\n", i, glb_call_stack[i]);
-    }
+    PRINT_CALL_STACK;
     EXIT (1);
   }
   if (signo == SIGSEGV)
   {
     printf ("%s %u pe: %u caught signo SIGSEGV : Invalid storage access\n",
             __FILE__, __LINE__, glb_mype);
-    printf ("Currently executing function: %s\n",
-            glb_call_stack[glb_call_stack_index]);
-    for (i = glb_call_stack_index; i >= 0; i--)
-    {
-      printf ("glb_call_stack[%d]= %s\n", i, glb_call_stack[i]);
-    }
+    PRINT_CALL_STACK;
     EXIT (1);
   }
   if (signo == SIGINT)
   {
     printf ("%s %u caught signo SIGINT : Interrupt\n",
             __FILE__, __LINE__);
-    printf ("Currently executing function: %s\n",
-            glb_call_stack[glb_call_stack_index]);
-    for (i = glb_call_stack_index; i >= 0; i--)
-    {
-      printf ("glb_call_stack[%d]= %s\n", i, glb_call_stack[i]);
-    }
+    PRINT_CALL_STACK;
     EXIT (1);
   }
   if (signo == SIGFPE)
   {
     printf ("%s %u caught signo SIGFPE : Floating-point exception\n",
             __FILE__, __LINE__);
-    printf ("Currently executing function: %s\n",
-            glb_call_stack[glb_call_stack_index]);
-    for (i = glb_call_stack_index; i >= 0; i--)
-    {
-      printf ("glb_call_stack[%d]= %s\n", i, glb_call_stack[i]);
-    }
+    PRINT_CALL_STACK;
     EXIT (1);
   }
 /* Added 06/15/2006 
@@ -1109,12 +1150,7 @@ void
   {
     printf ("%s %u caught signo SIGABRT : Abort\n",
             __FILE__, __LINE__);
-    printf ("Currently executing function: %s\n",
-            glb_call_stack[glb_call_stack_index]);
-    for (i = glb_call_stack_index; i >= 0; i--)
-    {
-      printf ("glb_call_stack[%d]= %s\n", i, glb_call_stack[i]);
-    }
+    PRINT_CALL_STACK;
     EXIT (1);
   }
  Added 06/15/2006 */
@@ -30,6 +30,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <limits.h>
 #include "globals.h"
 #include "igrid_obj.h"
 #include "pgrid_obj.h"
@@ -98,7 +99,7 @@ static int bytes_p_grid;
 static int bytes_p_grid_rounded2wordboundary;
 static int bytes_p_packed_grid;
 static int bytes_p_packed_grid_rounded2wordboundary;
-static int bytes2allocate;
+static size_t bytes2allocate;
 static void *mem_ptr;
 static int igrid_count;
 static int pgrid_count;
@@ -109,24 +110,56 @@ static char mem_log_filename[MAX_FILENAME_LEN];
 /* D.D. Added for growth Row and Column (GRC)arrays and for road-pixel-only */
 /*      (RPO) arrays  --  July 28, 2006                                     */
 static void *g_row_ptr;
-static short *g_col_ptr;
+static COORD_TYPE *g_col_ptr;
 static int *road_expansion_row_ptr;
 static int *road_expansion_col_ptr;
-static short *z_row_ptr; /* D.D. 8/17/2006 Added for accumulating urban     */
-static short *z_col_ptr; /*      pixels over year simulations.              */
+static COORD_TYPE *z_row_ptr; /* D.D. 8/17/2006 Added for accumulating urban     */
+static COORD_TYPE *z_col_ptr; /*      pixels over year simulations.              */
 static int   zgrwthcount;/*                                                 */
 static GRID_P zgrwthpointer;
-static int bytes2allocateGRC;
-static int bytes2allocateRERC;
+static size_t bytes2allocateGRC;
+static size_t bytes2allocateRERC;
 static int *roadLineRows_ptr;
 static int *roadLineCols_ptr;
+/* Uniform-grid spatial hash over the road expansion (RERC) pixels          */
+static int *rerh_head_ptr;
+static int *rerh_next_ptr;
+static int rerh_bucket_rows;
+static int rerh_bucket_cols;
+/* Urban frontier (UFR) arrays: urban pixels able to spread in phase 4     */
+static COORD_TYPE *ufr_row_ptr;
+static COORD_TYPE *ufr_col_ptr;
+static PIXEL *ufr_flag_ptr;
+/* Deltatron active set (DAS) arrays: live deltatrons and phase 2 candidates */
+static int *das_active_ptr;
+static int *das_candidate_ptr;
+static PIXEL *das_flag_ptr;
+/* Deltatron transition index (DTI) arrays: transitional pixels of the land */
+static int *dti_index_ptr;
+static int *dti_pos_ptr;
+/* Land change (LND) arrays: births of a year and pixels changed in a run */
+static int *lnd_log_ptr;
+static int *lnd_dirty_ptr;
+static PIXEL *lnd_flag_ptr;
+/* Road neighbor mask (RNM) grid: one bit per road neighbor of a pixel     */
+static PIXEL *rnm_ptr;
+/* Urbanize acceptance grid (UAG): combined slope and exclusion pass rate  */
+static unsigned short *uag_ptr;
+/* Tiled spread (TSP) buffers: per-tile growth, urban index and deferred   */
+/* write lists (see spr_tiled_spread)                                      */
+static COORD_TYPE *tsp_grow_row_ptr;
+static COORD_TYPE *tsp_grow_col_ptr;
+static int *tsp_zidx_ptr;
+static COORD_TYPE *tsp_defer_row_ptr;
+static COORD_TYPE *tsp_defer_col_ptr;
+static PIXEL *tsp_defer_val_ptr;
 
 static int bytes2allocateRPOcol;
-static short *rporowNum_ptr;
-static short *rporowMin_ptr;
-static short *rporowMax_ptr;
+static COORD_TYPE *rporowNum_ptr;
+static COORD_TYPE *rporowMin_ptr;
+static COORD_TYPE *rporowMax_ptr;
 static int   *rporowIdx_ptr;
-static short *rpocol_ptr;
+static COORD_TYPE *rpocol_ptr;
 /**  D.D.  July 28, 2006                                   *******************/
 
 /*****************************************************************************\
@@ -196,7 +229,7 @@ void
   LOG_MEM (fp, &bytes_p_grid_rounded2wordboundary, sizeof (int), 1);
   LOG_MEM (fp, &bytes_p_packed_grid, sizeof (int), 1);
   LOG_MEM (fp, &bytes_p_packed_grid_rounded2wordboundary, sizeof (int), 1);
-  LOG_MEM (fp, &bytes2allocate, sizeof (int), 1);
+  LOG_MEM (fp, &bytes2allocate, sizeof (size_t), 1);
   LOG_MEM (fp, &mem_ptr, sizeof (void *), 1);
   LOG_MEM (fp, &igrid_count, sizeof (int), 1);
   LOG_MEM (fp, &pgrid_count, sizeof (int), 1);
@@ -384,6 +417,13 @@ void
   wgrid_free_tos = 0;
   nrows = igrid_GetNumRows ();
   ncols = igrid_GetNumCols ();
+  if ((double) nrows * (double) ncols > (double) INT_MAX)
+  {
+    sprintf (msg_buf, "Grid of %d x %d pixels exceeds %d pixels",
+             nrows, ncols, INT_MAX);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
   total_pixels = nrows * ncols;
   igrid_count = igrid_GetIGridCount ();
   pgrid_count = pgrid_GetPGridCount ();
@@ -398,15 +438,15 @@ void
   bytes_p_packed_grid = BYTES_PER_PIXEL_PACKED * total_pixels;
   bytes_p_packed_grid_rounded2wordboundary =
     ROUND_BYTES_TO_WORD_BNDRY (bytes_p_packed_grid);
-  bytes2allocate = igrid_count * bytes_p_packed_grid_rounded2wordboundary +
-    pgrid_count * bytes_p_grid_rounded2wordboundary +
-    wgrid_count * bytes_p_grid_rounded2wordboundary +
+  bytes2allocate = (size_t) igrid_count * bytes_p_packed_grid_rounded2wordboundary +
+    (size_t) pgrid_count * bytes_p_grid_rounded2wordboundary +
+    (size_t) wgrid_count * bytes_p_grid_rounded2wordboundary +
     check_pixel_count * BYTES_PER_PIXEL;
   igrid_size = bytes_p_packed_grid_rounded2wordboundary / BYTES_PER_WORD;
 #else
-  bytes2allocate = igrid_count * bytes_p_grid_rounded2wordboundary +
-    pgrid_count * bytes_p_grid_rounded2wordboundary +
-    wgrid_count * bytes_p_grid_rounded2wordboundary +
+  bytes2allocate = (size_t) igrid_count * bytes_p_grid_rounded2wordboundary +
+    (size_t) pgrid_count * bytes_p_grid_rounded2wordboundary +
+    (size_t) wgrid_count * bytes_p_grid_rounded2wordboundary +
     check_pixel_count * BYTES_PER_PIXEL;
   igrid_size = bytes_p_grid_rounded2wordboundary / BYTES_PER_WORD;
 
@@ -414,16 +454,10 @@ void
 /*        Allows for up to half the pixels in a grid to be used for new     ***/
 /*        growth pixels or 15,000,000 - whichever is less.   (8/17/2006)       ***/
 /*   D.D. Type of storage to be allocated changed from int to short 8/10/2006 */
-  if (bytes_p_grid_rounded2wordboundary/2 > 15000000) {
-	  bytes2allocateGRC=15000000*sizeof(short);
-	  bytes2allocateRERC = 15000000 * sizeof(int);
-
-  }
-      else
-  {
-	  bytes2allocateGRC = (bytes_p_grid_rounded2wordboundary/2)*sizeof(short);
-	  bytes2allocateRERC = (bytes_p_grid_rounded2wordboundary / 2) * sizeof(int);
-  }
+/*   agent 10/19/2026 The 15,000,000 cap is removed: on large grids it let   */
+/*        the growth and Z lists overrun. Entries are now COORD_TYPE.        */
+  bytes2allocateGRC = (size_t) (bytes_p_grid_rounded2wordboundary / 2) * sizeof (COORD_TYPE);
+  bytes2allocateRERC = (size_t) (bytes_p_grid_rounded2wordboundary / 2) * sizeof (int);
 
 #endif
   mem_check_size = 1;
@@ -458,7 +492,8 @@ void
     fprintf (memlog_fp, "pgrid_size = %u words\n", pgrid_size);
     fprintf (memlog_fp, "wgrid_size = %u words\n", wgrid_size);
     fprintf (memlog_fp, "mem_check_size = %u words\n", mem_check_size);
-    fprintf (memlog_fp, "bytes2allocate = %u\n", bytes2allocate);
+    fprintf (memlog_fp, "bytes2allocate = %llu\n",
+             (unsigned long long) bytes2allocate);
   }
 
   mem_allocate ();
@@ -769,20 +804,25 @@ static void
 {
   char func[] = "mem_allocate";
   int i;
+  size_t bytes2allocateUFR;
+  int tsp_tiles;
+  int tsp_tile_pixels;
+  int tsp_halo_pixels;
 
   /** Allocate memory for igrids, pgrids, and wgrids **/
   mem_ptr = malloc (bytes2allocate);
   if (mem_ptr == NULL)
   {
-    sprintf (msg_buf, "Unable to allocate %u bytes of memory", bytes2allocate);
+    sprintf (msg_buf, "Unable to allocate %llu bytes of memory",
+             (unsigned long long) bytes2allocate);
     LOG_ERROR (msg_buf);
     EXIT (1);
   }
   if (scen_GetLogFlag ())
   {
     scen_Append2Log ();
-    fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory\n",
-             __FILE__, __LINE__, bytes2allocate);
+    fprintf (scen_GetLogFP (), "%s %u Allocated %llu bytes of memory\n",
+             __FILE__, __LINE__, (unsigned long long) bytes2allocate);
     scen_CloseLog ();
   }
   memset (mem_ptr, 0, bytes2allocate);
@@ -793,21 +833,21 @@ static void
   road_expansion_row_ptr = malloc(bytes2allocateRERC);
 
 /* D.D. 8/24/2006 Allow Z to use twice the pixels of delta            ***
-** when bytes2allocateGRC is less than 7,500,000.                     **/
-  if (bytes2allocateGRC < 7500000) { z_row_ptr = malloc (2*bytes2allocateGRC); }
-     else { z_row_ptr = malloc ( bytes2allocateGRC); }
+** agent 10/19/2026 Now always twice, since the GRC cap is gone.      **/
+  z_row_ptr = malloc (2*bytes2allocateGRC);
 
   if ( (g_row_ptr == NULL) || (z_row_ptr == NULL) || (road_expansion_row_ptr) == NULL)
   {
-	  sprintf (msg_buf, "Unable to allocate %u bytes of memory (GRC row)", bytes2allocateGRC*3 + bytes2allocateRERC);
+	  sprintf (msg_buf, "Unable to allocate %llu bytes of memory (GRC row)",
+	           (unsigned long long) (bytes2allocateGRC*3 + bytes2allocateRERC));
     LOG_ERROR (msg_buf);
     EXIT (1);
   }
   if (scen_GetLogFlag ())
   {
     scen_Append2Log ();
-    fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (GRC row)\n",
-             __FILE__, __LINE__, bytes2allocateGRC);
+    fprintf (scen_GetLogFP (), "%s %u Allocated %llu bytes of memory (GRC row)\n",
+             __FILE__, __LINE__, (unsigned long long) bytes2allocateGRC);
     scen_CloseLog ();
   }
   
@@ -816,28 +856,174 @@ static void
   // Allcoate memory for road expansion col array
   road_expansion_col_ptr = malloc(bytes2allocateRERC);
 /* D.D. 8/24/2006 Allow Z to use twice the pixels of delta            ***
-** when bytes2allocateGRC is less than 7,500,000.                     **/
-  if (bytes2allocateGRC < 7500000) { z_col_ptr = malloc (2*bytes2allocateGRC); }
-     else { z_col_ptr = malloc ( bytes2allocateGRC); }
+** agent 10/19/2026 Now always twice, since the GRC cap is gone.      **/
+  z_col_ptr = malloc (2*bytes2allocateGRC);
   if ( (g_col_ptr == NULL) || (z_col_ptr == NULL) || (road_expansion_col_ptr) == NULL)
   {
-    sprintf (msg_buf, "Unable to allocate %u bytes of memory (GRC col)", bytes2allocateGRC*3 + bytes2allocateRERC);
+    sprintf (msg_buf, "Unable to allocate %llu bytes of memory (GRC col)",
+             (unsigned long long) (bytes2allocateGRC*3 + bytes2allocateRERC));
     LOG_ERROR (msg_buf);
     EXIT (1);
   }
   if (scen_GetLogFlag ())
   {
     scen_Append2Log ();
-    fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (GRC col)\n",
-             __FILE__, __LINE__, bytes2allocateGRC);
+    fprintf (scen_GetLogFP (), "%s %u Allocated %llu bytes of memory (GRC col)\n",
+             __FILE__, __LINE__, (unsigned long long) bytes2allocateGRC);
     scen_CloseLog ();
   }
+
+  /** Allocate memory for the urban frontier arrays (same size as Z). **/
+  if (scen_GetUrbanFrontierFlag ())
+  {
+    bytes2allocateUFR = 2*bytes2allocateGRC;
+    ufr_row_ptr = malloc (bytes2allocateUFR);
+    ufr_col_ptr = malloc (bytes2allocateUFR);
+    ufr_flag_ptr = malloc (total_pixels * sizeof (PIXEL));
+    if ( (ufr_row_ptr == NULL) || (ufr_col_ptr == NULL) || (ufr_flag_ptr == NULL) )
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (UFR)",
+               2*bytes2allocateUFR + total_pixels * sizeof (PIXEL));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (UFR)\n",
+               __FILE__, __LINE__, 2*bytes2allocateUFR + total_pixels * sizeof (PIXEL));
+      scen_CloseLog ();
+    }
+  }
+
+  /** Allocate memory for the deltatron active set arrays. **/
+  if (scen_GetSparseDeltatronFlag ())
+  {
+    das_active_ptr = malloc (total_pixels * sizeof (int));
+    das_candidate_ptr = malloc (total_pixels * sizeof (int));
+    das_flag_ptr = calloc (total_pixels, sizeof (PIXEL));
+    if ((das_active_ptr == NULL) || (das_candidate_ptr == NULL) ||
+        (das_flag_ptr == NULL))
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (DAS)",
+               total_pixels * (2 * sizeof (int) + sizeof (PIXEL)));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (DAS)\n",
+               __FILE__, __LINE__,
+               total_pixels * (2 * sizeof (int) + sizeof (PIXEL)));
+      scen_CloseLog ();
+    }
+  }
+
+  /** Allocate memory for the deltatron transition index arrays. **/
+  if (scen_GetIndexedDeltatronCentersFlag ())
+  {
+    dti_index_ptr = malloc (total_pixels * sizeof (int));
+    dti_pos_ptr = malloc (total_pixels * sizeof (int));
+    if ((dti_index_ptr == NULL) || (dti_pos_ptr == NULL))
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (DTI)",
+               total_pixels * 2 * sizeof (int));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (DTI)\n",
+               __FILE__, __LINE__, total_pixels * 2 * sizeof (int));
+      scen_CloseLog ();
+    }
+  }
+
+  /** Allocate memory for the land change arrays. **/
+  if (scen_GetDoingLanduseFlag ())
+  {
+    lnd_log_ptr = malloc (total_pixels * sizeof (int));
+    lnd_dirty_ptr = malloc (total_pixels * sizeof (int));
+    lnd_flag_ptr = calloc (total_pixels, sizeof (PIXEL));
+    if ((lnd_log_ptr == NULL) || (lnd_dirty_ptr == NULL) ||
+        (lnd_flag_ptr == NULL))
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (LND)",
+               total_pixels * (2 * sizeof (int) + sizeof (PIXEL)));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (LND)\n",
+               __FILE__, __LINE__,
+               total_pixels * (2 * sizeof (int) + sizeof (PIXEL)));
+      scen_CloseLog ();
+    }
+  }
+
+  /** Allocate memory for the urbanize acceptance grid. **/
+  if (scen_GetUrbanizeAcceptanceGridFlag ())
+  {
+    uag_ptr = malloc (total_pixels * sizeof (unsigned short));
+    if (uag_ptr == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (UAG)",
+               total_pixels * sizeof (unsigned short));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (UAG)\n",
+               __FILE__, __LINE__, total_pixels * sizeof (unsigned short));
+      scen_CloseLog ();
+    }
+  }
  
+  /** Allocate memory for the tiled spread buffers. **/
+  if (scen_GetTiledSpreadFlag ())
+  {
+    tsp_tiles = ((nrows + SPREAD_TILE_SIZE - 1) / SPREAD_TILE_SIZE) *
+                ((ncols + SPREAD_TILE_SIZE - 1) / SPREAD_TILE_SIZE);
+    tsp_tile_pixels = SPREAD_TILE_SIZE * SPREAD_TILE_SIZE;
+    tsp_halo_pixels = 4 * SPREAD_TILE_SIZE + 4;
+    tsp_grow_row_ptr = malloc (tsp_tiles * tsp_tile_pixels * sizeof (COORD_TYPE));
+    tsp_grow_col_ptr = malloc (tsp_tiles * tsp_tile_pixels * sizeof (COORD_TYPE));
+    tsp_zidx_ptr = malloc (tsp_tiles * tsp_tile_pixels * sizeof (int));
+    tsp_defer_row_ptr = malloc (tsp_tiles * tsp_halo_pixels * sizeof (COORD_TYPE));
+    tsp_defer_col_ptr = malloc (tsp_tiles * tsp_halo_pixels * sizeof (COORD_TYPE));
+    tsp_defer_val_ptr = malloc (tsp_tiles * tsp_halo_pixels * sizeof (PIXEL));
+    if ( (tsp_grow_row_ptr == NULL) || (tsp_grow_col_ptr == NULL) ||
+         (tsp_zidx_ptr == NULL) || (tsp_defer_row_ptr == NULL) ||
+         (tsp_defer_col_ptr == NULL) || (tsp_defer_val_ptr == NULL) )
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (TSP)",
+               tsp_tiles * (tsp_tile_pixels * (2 * sizeof (COORD_TYPE) + sizeof (int)) +
+                            tsp_halo_pixels * (2 * sizeof (COORD_TYPE) + sizeof (PIXEL))));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (scen_GetLogFlag ())
+    {
+      scen_Append2Log ();
+      fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (TSP)\n",
+               __FILE__, __LINE__,
+               tsp_tiles * (tsp_tile_pixels * (2 * sizeof (COORD_TYPE) + sizeof (int)) +
+                            tsp_halo_pixels * (2 * sizeof (COORD_TYPE) + sizeof (PIXEL))));
+      scen_CloseLog ();
+    }
+  }
+
   /** Allocate memory for the Road-Pixel-Only row array. **/
   /** "sizeof(int)" changed to "sizeof(short)" 8/10/2006  **/
-	rporowNum_ptr = malloc(nrows*sizeof(short));
-	rporowMin_ptr = malloc(nrows*sizeof(short));
-	rporowMax_ptr = malloc(nrows*sizeof(short));
+	rporowNum_ptr = malloc(nrows*sizeof(COORD_TYPE));
+	rporowMin_ptr = malloc(nrows*sizeof(COORD_TYPE));
+	rporowMax_ptr = malloc(nrows*sizeof(COORD_TYPE));
 	rporowIdx_ptr = malloc(nrows*sizeof(int  ));
 		if (
 			rporowNum_ptr == NULL ||
@@ -846,7 +1032,7 @@ static void
 			rporowIdx_ptr == NULL 
 			)
 		{
-			sprintf (msg_buf, "Unable to allocate %u bytes of memory (RPO row)", 3*nrows*sizeof(short)+nrows*sizeof(int));
+			sprintf (msg_buf, "Unable to allocate %u bytes of memory (RPO row)", 3*nrows*sizeof(COORD_TYPE)+nrows*sizeof(int));
 			LOG_ERROR (msg_buf);
 			EXIT (1);
 		}
@@ -854,13 +1040,53 @@ static void
 		{
 			scen_Append2Log ();
 			fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (RPO row)\n",
-					__FILE__, __LINE__, 4*nrows*sizeof(short));
+					__FILE__, __LINE__, 4*nrows*sizeof(COORD_TYPE));
 			scen_CloseLog ();
 		}
 
 	/* Allocate memory for new road line pointer arrays*/
 		roadLineRows_ptr = malloc(nrows * sizeof(int));
 		roadLineCols_ptr = malloc(ncols * sizeof(int));
+
+	/* Allocate memory for the road expansion spatial hash (RERH): one list
+	   head per ROAD_EXPANSION_BUCKET_SIZE square bucket and one link per
+	   RERC entry */
+		rerh_bucket_rows = (nrows + ROAD_EXPANSION_BUCKET_SIZE - 1) / ROAD_EXPANSION_BUCKET_SIZE;
+		rerh_bucket_cols = (ncols + ROAD_EXPANSION_BUCKET_SIZE - 1) / ROAD_EXPANSION_BUCKET_SIZE;
+		rerh_head_ptr = malloc(rerh_bucket_rows * rerh_bucket_cols * sizeof(int));
+		rerh_next_ptr = malloc(bytes2allocateRERC);
+		if (rerh_head_ptr == NULL || rerh_next_ptr == NULL)
+		{
+			sprintf (msg_buf, "Unable to allocate %u bytes of memory (RERH)",
+				rerh_bucket_rows * rerh_bucket_cols * sizeof(int) + bytes2allocateRERC);
+			LOG_ERROR (msg_buf);
+			EXIT (1);
+		}
+		if (scen_GetLogFlag ())
+		{
+			scen_Append2Log ();
+			fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (RERH)\n",
+				__FILE__, __LINE__, rerh_bucket_rows * rerh_bucket_cols * sizeof(int) + bytes2allocateRERC);
+			scen_CloseLog ();
+		}
+
+	/* Allocate memory for the road neighbor mask grid (RNM) used by the
+	   road walk */
+		rnm_ptr = malloc(total_pixels * sizeof(PIXEL));
+		if (rnm_ptr == NULL)
+		{
+			sprintf (msg_buf, "Unable to allocate %u bytes of memory (RNM)",
+				total_pixels * sizeof(PIXEL));
+			LOG_ERROR (msg_buf);
+			EXIT (1);
+		}
+		if (scen_GetLogFlag ())
+		{
+			scen_Append2Log ();
+			fprintf (scen_GetLogFP (), "%s %u Allocated %u bytes of memory (RNM)\n",
+				__FILE__, __LINE__, total_pixels * sizeof(PIXEL));
+			scen_CloseLog ();
+		}
 }
 
 /******************************************************************************
@@ -1139,7 +1365,7 @@ void
 **                row array used to keep track of new growth pixels.
 **
 */
-short*
+COORD_TYPE*
   mem_GetGRCrowptr ()
 {
   return g_row_ptr;
@@ -1157,7 +1383,7 @@ short*
 **                column array used to keep track of new growth pixels.
 **
 */
-short*
+COORD_TYPE*
   mem_GetGRCcolptr ()
 {
   return g_col_ptr;
@@ -1198,6 +1424,400 @@ mem_GetRERCcolptr()
 	return road_expansion_col_ptr;
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetRERHheadptr
+** PURPOSE:       return a pointer to the road expansion hash bucket heads
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the array holding, for each bucket of
+**                the road expansion spatial hash, the RERC index of the last
+**                pixel stored in it (-1 for an empty bucket).
+**
+*/
+int*
+mem_GetRERHheadptr()
+{
+	return rerh_head_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetRERHnextptr
+** PURPOSE:       return a pointer to the road expansion hash links
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the array chaining each RERC entry to
+**                the previous entry stored in the same bucket.
+**
+*/
+int*
+mem_GetRERHnextptr()
+{
+	return rerh_next_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetRERHbucketRows
+** PURPOSE:       return the number of bucket rows of the road expansion hash
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+mem_GetRERHbucketRows()
+{
+	return rerh_bucket_rows;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetRERHbucketCols
+** PURPOSE:       return the number of bucket cols of the road expansion hash
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+mem_GetRERHbucketCols()
+{
+	return rerh_bucket_cols;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetUFRrowptr
+** PURPOSE:       return a pointer to memory allocated for the UFR row array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the starting memory location for the
+**                row array of the urban frontier (urban interior pixels
+**                with 2 to 7 urban neighbors).
+**
+*/
+COORD_TYPE*
+mem_GetUFRrowptr()
+{
+	return ufr_row_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetUFRcolptr
+** PURPOSE:       return a pointer to memory allocated for the UFR col array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the starting memory location for the
+**                column array of the urban frontier.
+**
+*/
+COORD_TYPE*
+mem_GetUFRcolptr()
+{
+	return ufr_col_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetUFRflagptr
+** PURPOSE:       return a pointer to memory allocated for the UFR flag grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the grid marking the pixels which have
+**                already entered the urban frontier.
+**
+*/
+PIXEL*
+mem_GetUFRflagptr()
+{
+	return ufr_flag_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetDASactiveptr
+** PURPOSE:       return a pointer to the deltatron active set array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Holds the offsets of the pixels whose deltatron is not
+**                zero.
+**
+*/
+int*
+mem_GetDASactiveptr()
+{
+	return das_active_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetDAScandidateptr
+** PURPOSE:       return a pointer to the deltatron phase 2 candidate array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Holds the offsets of the pixels next to a deltatron of
+**                age 2.
+**
+*/
+int*
+mem_GetDAScandidateptr()
+{
+	return das_candidate_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetDASflagptr
+** PURPOSE:       return a pointer to the deltatron candidate flag grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Marks the pixels already in the candidate array; all
+**                zero between two phase 2 passes.
+**
+*/
+PIXEL*
+mem_GetDASflagptr()
+{
+	return das_flag_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetDTIindexptr
+** PURPOSE:       return a pointer to the deltatron transition index array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Holds the offsets of the pixels whose land use class
+**                may transition.
+**
+*/
+int*
+mem_GetDTIindexptr()
+{
+	return dti_index_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetDTIposptr
+** PURPOSE:       return a pointer to the deltatron transition position grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Position of each pixel in the transition index, or -1.
+**
+*/
+int*
+mem_GetDTIposptr()
+{
+	return dti_pos_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetLNDlogptr
+** PURPOSE:       return a pointer to the deltatron birth log array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Holds the offsets of the pixels born during the current
+**                call of the deltatron.
+**
+*/
+int*
+mem_GetLNDlogptr()
+{
+	return lnd_log_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetLNDdirtyptr
+** PURPOSE:       return a pointer to the changed land pixel array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Holds the offsets of the pixels of the land grids which
+**                changed since they were initialized.
+**
+*/
+int*
+mem_GetLNDdirtyptr()
+{
+	return lnd_dirty_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetLNDflagptr
+** PURPOSE:       return a pointer to the changed land pixel flag grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Marks the pixels already in the changed pixel array.
+**
+*/
+PIXEL*
+mem_GetLNDflagptr()
+{
+	return lnd_flag_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetRNMptr
+** PURPOSE:       return a pointer to memory allocated for the RNM grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the road neighbor mask grid. Bit k of
+**                a pixel is set when its neighbor k, in the order used by
+**                util_get_next_neighbor, is a road pixel.
+**
+*/
+PIXEL*
+mem_GetRNMptr()
+{
+	return rnm_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetUAGptr
+** PURPOSE:       return a pointer to memory allocated for the UAG grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the urbanize acceptance grid, the
+**                per-pixel probability, scaled to 16 bits, that an
+**                urbanization attempt passes both the slope and the
+**                exclusion tests.
+**
+*/
+unsigned short*
+mem_GetUAGptr()
+{
+	return uag_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPgrowRowPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP growth row array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile growth row arrays of the
+**                tiled spread, SPREAD_TILE_SIZE squared entries per tile.
+**
+*/
+COORD_TYPE*
+mem_GetTSPgrowRowPtr()
+{
+	return tsp_grow_row_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPgrowColPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP growth col array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile growth column arrays of
+**                the tiled spread.
+**
+*/
+COORD_TYPE*
+mem_GetTSPgrowColPtr()
+{
+	return tsp_grow_col_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPzIdxPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP urban index array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile arrays of indices into the
+**                zgrwth arrays, used to bucket the urban pixels by tile.
+**
+*/
+int*
+mem_GetTSPzIdxPtr()
+{
+	return tsp_zidx_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPdeferRowPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP deferred row array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile arrays of deferred writes
+**                (pixels just outside a tile), 4 * SPREAD_TILE_SIZE + 4
+**                entries per tile.
+**
+*/
+COORD_TYPE*
+mem_GetTSPdeferRowPtr()
+{
+	return tsp_defer_row_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPdeferColPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP deferred col array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile deferred column arrays.
+**
+*/
+COORD_TYPE*
+mem_GetTSPdeferColPtr()
+{
+	return tsp_defer_col_ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: mem_GetTSPdeferValPtr
+** PURPOSE:       return a pointer to memory allocated for the TSP deferred value array
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Returns a pointer to the per-tile deferred value arrays
+**                (the phase growth value to write).
+**
+*/
+PIXEL*
+mem_GetTSPdeferValPtr()
+{
+	return tsp_defer_val_ptr;
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: mem_GetRPOrowptrNum
@@ -1209,7 +1829,7 @@ mem_GetRERCcolptr()
 **                Road-Pixel-Only row array for the number of columns with
 **                road pixels in the row. The argument is the row number.
 */
-short*
+COORD_TYPE*
   mem_GetRPOrowptrNum ()
 {
   return rporowNum_ptr;
@@ -1226,7 +1846,7 @@ short*
 **                Road-Pixel-Only row array for the minimum column with a road
 **                pixel in the row. The argument is the row number.
 */
-short*
+COORD_TYPE*
   mem_GetRPOrowptrMin ()
 {
   return rporowMin_ptr;
@@ -1243,7 +1863,7 @@ short*
 **                Road-Pixel-Only row array for the maximum column with a road
 **                pixel in the row. The argument is the row number.
 */
-short*
+COORD_TYPE*
   mem_GetRPOrowptrMax()
 {
   return rporowMax_ptr;
@@ -1278,7 +1898,7 @@ int*
 **                Road-Pixel-Only column array for the index passed as a
 **                parameter.
 */
-short*
+COORD_TYPE*
   mem_GetRPOcolptr ()
 {
   return rpocol_ptr;
@@ -1302,7 +1922,7 @@ void
           column array. */
   
  char func[] = "mem_AllocateRPOcol";
- bytes2allocateRPOcol = (pgrid_GetRoadStatePixelCount() + 20) * sizeof(short);
+ bytes2allocateRPOcol = (pgrid_GetRoadStatePixelCount() + 20) * sizeof(COORD_TYPE);
  rpocol_ptr = malloc(bytes2allocateRPOcol);
 
 /**  D.D. Code added August 1, 2006                                          ***/
@@ -1321,7 +1941,7 @@ void
 **                
 **                
 */
-short*
+COORD_TYPE*
   mem_GetGRZrowptr()
 {
   return z_row_ptr;
@@ -1338,7 +1958,7 @@ short*
 **                
 **                
 */
-short*
+COORD_TYPE*
   mem_GetGRZcolptr()
 {
   return z_col_ptr;
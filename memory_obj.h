@@ -43,26 +43,51 @@ void mem_CloseLog();
 
 /* D.D. Added for growth Row and Column (GRC) arrays - July 28, 2006 */
 /* D.D. Return type changed to short August 10, 2006                 */
-short *mem_GetGRCrowptr ();
-short *mem_GetGRCcolptr ();
+COORD_TYPE *mem_GetGRCrowptr ();
+COORD_TYPE *mem_GetGRCcolptr ();
 
 int *mem_GetRERCrowptr();
 int *mem_GetRERCcolptr();
 
+int *mem_GetRERHheadptr();
+int *mem_GetRERHnextptr();
+int  mem_GetRERHbucketRows();
+int  mem_GetRERHbucketCols();
+
+COORD_TYPE *mem_GetUFRrowptr();
+COORD_TYPE *mem_GetUFRcolptr();
+PIXEL *mem_GetUFRflagptr();
+int *mem_GetDASactiveptr();
+int *mem_GetDAScandidateptr();
+PIXEL *mem_GetDASflagptr();
+int *mem_GetDTIindexptr();
+int *mem_GetDTIposptr();
+int *mem_GetLNDlogptr();
+int *mem_GetLNDdirtyptr();
+PIXEL *mem_GetLNDflagptr();
+PIXEL *mem_GetRNMptr();
+unsigned short *mem_GetUAGptr();
+COORD_TYPE *mem_GetTSPgrowRowPtr();
+COORD_TYPE *mem_GetTSPgrowColPtr();
+int   *mem_GetTSPzIdxPtr();
+COORD_TYPE *mem_GetTSPdeferRowPtr();
+COORD_TYPE *mem_GetTSPdeferColPtr();
+PIXEL *mem_GetTSPdeferValPtr();
+
 /* D.D. Added for cumulative growth array - 8/17/2006                */
-short *mem_GetGRZrowptr ();
-short *mem_GetGRZcolptr ();
+COORD_TYPE *mem_GetGRZrowptr ();
+COORD_TYPE *mem_GetGRZcolptr ();
 int    mem_GetGRZcount ();
 void   mem_SetGRZcount (int);
 GRID_P mem_GetGRZpointer();
 void   mem_SetGRZpointer(GRID_P);
 /* D.D. Added for cumulative growth array - 8/17/2006                */
 
-short *mem_GetRPOrowptrNum ();
-short *mem_GetRPOrowptrMin ();
-short *mem_GetRPOrowptrMax ();
+COORD_TYPE *mem_GetRPOrowptrNum ();
+COORD_TYPE *mem_GetRPOrowptrMin ();
+COORD_TYPE *mem_GetRPOrowptrMax ();
 int   *mem_GetRPOrowptrIdx ();
-short *mem_GetRPOcolptr ();
+COORD_TYPE *mem_GetRPOcolptr ();
 /**  D.D.  July 28, 2006                                   *******************/
 
 /**  D.D.  Added for road-pixel-only (RPO) column arrays - Aug. 1, 2006    ***/
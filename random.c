@@ -90,6 +90,39 @@ double
 }
 /* (C) Copr. 1986-92 Numerical Recipes Software '%12'%. */
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: ran_stream_random
+** PURPOSE:       generate random number from an independent stream
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   minimal standard generator (the recurrence underlying
+**                ran_random) without the shuffle table, so that the whole
+**                state lives in *state. Several streams can then be drawn
+**                from concurrently. *state must be in [1, 2147483646].
+**
+*/
+double
+  ran_stream_random (RANDOM_SEED_TYPE * state)
+{
+  RANDOM_SEED_TYPE k;
+  double random_num;
+
+  k = (*state) / 127773;
+  (*state) = 16807 * ((*state) - k * 127773) - 2836 * k;
+  if ((*state) < 0)
+  {
+    (*state) += 2147483647;
+  }
+  random_num = (1.0 / 2147483647) * (*state);
+  if (random_num > (1.0 - 1.2e-7))
+  {
+    random_num = 1.0 - 1.2e-7;
+  }
+  return random_num;
+}
+
 
 /******************************************************************************
 *******************************************************************************
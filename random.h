@@ -31,5 +31,6 @@ char random_h_sccs_id[] = "@(#)random.h	1.230	12/4/00";
 
 
 double ran_random(RANDOM_SEED_TYPE*);
+double ran_stream_random(RANDOM_SEED_TYPE*);
 void  InitRandom (RANDOM_SEED_TYPE);
 #endif
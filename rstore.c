@@ -0,0 +1,390 @@
+/*******************************************************************************
+
+  MODULE:                   rstore.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This is a stand-alone program which reads the results store written
+     when WRITE_RESULTS_STORE is set (see rstore_obj.h) and exports its
+     tables as CSV.
+
+        rstore <output dir>                        lists the tables
+        rstore <output dir> <table> [column ...]   writes the table, or
+                                                   only the given columns,
+                                                   as CSV to stdout
+
+     Only the requested columns are read from the segments.
+
+  NOTES:
+
+     Build with "make rstore". The program does not link with the model.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "rstore_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static char dir[MAX_FILENAME_LEN];
+static int num_segments;
+static int num_tables;
+static int num_entries;
+static char (*segment_names)[RSTORE_NAME_LEN];
+static FILE **segment_fps;
+static rstore_schema *schemas;
+static rstore_index_entry *entries;
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                        STATIC FUNCTION PROTOTYPES                         **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static void rstore_fail (char *msg, char *arg);
+static void *rstore_alloc (size_t size);
+static void rstore_read_index ();
+static void rstore_list ();
+static void rstore_export (char *table, int num_names, char *names[]);
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: main
+** PURPOSE:       list or export the tables of a results store
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+  main (int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    fprintf (stderr, "usage: %s <output dir> [<table> [column ...]]\n",
+             argv[0]);
+    return 1;
+  }
+  if (strlen (argv[1]) + 2 > MAX_FILENAME_LEN)
+  {
+    rstore_fail ("path too long:", argv[1]);
+  }
+  strcpy (dir, argv[1]);
+  if ((dir[0] != '\0') && (dir[strlen (dir) - 1] != '/'))
+  {
+    strcat (dir, "/");
+  }
+
+  rstore_read_index ();
+  if (argc == 2)
+  {
+    rstore_list ();
+  }
+  else
+  {
+    rstore_export (argv[2], argc - 3, argv + 3);
+  }
+  return 0;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_read_index
+** PURPOSE:       load the index of the store
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void
+  rstore_read_index ()
+{
+  char filename[MAX_FILENAME_LEN + RSTORE_NAME_LEN];
+  char magic[RSTORE_MAGIC_LEN];
+  int header[4];
+  FILE *fp;
+
+  sprintf (filename, "%s%s", dir, RSTORE_INDEX_FILE);
+  fp = fopen (filename, "rb");
+  if (fp == NULL)
+  {
+    rstore_fail ("unable to open", filename);
+  }
+  if ((fread (magic, 1, RSTORE_MAGIC_LEN, fp) != RSTORE_MAGIC_LEN) ||
+      memcmp (magic, RSTORE_INDEX_MAGIC, RSTORE_MAGIC_LEN) ||
+      (fread (header, sizeof (int), 4, fp) != 4) ||
+      (header[0] < 0) || (header[1] < 0) || (header[2] < 0))
+  {
+    rstore_fail ("not a results index:", filename);
+  }
+  num_segments = header[0];
+  num_tables = header[1];
+  num_entries = header[2];
+
+  segment_names = rstore_alloc (num_segments * (size_t) RSTORE_NAME_LEN);
+  segment_fps = rstore_alloc (num_segments * sizeof (FILE *));
+  schemas = rstore_alloc (num_tables * sizeof (rstore_schema));
+  entries = rstore_alloc (num_entries * sizeof (rstore_index_entry));
+  memset (segment_fps, 0, num_segments * sizeof (FILE *));
+  if ((fread (segment_names, RSTORE_NAME_LEN, num_segments, fp) !=
+       (size_t) num_segments) ||
+      (fread (schemas, sizeof (rstore_schema), num_tables, fp) !=
+       (size_t) num_tables) ||
+      (fread (entries, sizeof (rstore_index_entry), num_entries, fp) !=
+       (size_t) num_entries))
+  {
+    rstore_fail ("truncated results index:", filename);
+  }
+  fclose (fp);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_list
+** PURPOSE:       print the tables, their row counts and columns
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void
+  rstore_list ()
+{
+  long long rows;
+  int i;
+  int j;
+
+  for (i = 0; i < num_tables; i++)
+  {
+    rows = 0;
+    for (j = 0; j < num_entries; j++)
+    {
+      if (entries[j].table == i)
+      {
+        rows += entries[j].rows;
+      }
+    }
+    printf ("%s %lld rows:", schemas[i].name, rows);
+    for (j = 0; j < schemas[i].num_columns; j++)
+    {
+      printf (" %s", schemas[i].columns[j]);
+    }
+    printf ("\n");
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_export
+** PURPOSE:       write columns of a table as CSV to stdout
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   All the columns when num_names is 0. Rows come out
+**                segment by segment, in the order they were written.
+**
+*/
+static void
+  rstore_export (char *table, int num_names, char *names[])
+{
+  char filename[MAX_FILENAME_LEN + RSTORE_NAME_LEN];
+  rstore_schema *schema;
+  rstore_index_entry *entry;
+  int columns[RSTORE_MAX_COLUMNS];
+  int num_columns;
+  void *values[RSTORE_MAX_COLUMNS];
+  FILE *fp;
+  int t;
+  int i;
+  int j;
+  int row;
+  int max_rows;
+
+  for (t = 0; t < num_tables; t++)
+  {
+    if (!strcmp (schemas[t].name, table))
+    {
+      break;
+    }
+  }
+  if (t == num_tables)
+  {
+    rstore_fail ("no such table:", table);
+  }
+  schema = &schemas[t];
+
+  if (num_names == 0)
+  {
+    num_columns = schema->num_columns;
+    for (i = 0; i < num_columns; i++)
+    {
+      columns[i] = i;
+    }
+  }
+  else
+  {
+    if (num_names > RSTORE_MAX_COLUMNS)
+    {
+      rstore_fail ("too many columns for table", table);
+    }
+    num_columns = num_names;
+    for (i = 0; i < num_names; i++)
+    {
+      for (j = 0; j < schema->num_columns; j++)
+      {
+        if (!strcmp (schema->columns[j], names[i]))
+        {
+          break;
+        }
+      }
+      if (j == schema->num_columns)
+      {
+        rstore_fail ("no such column:", names[i]);
+      }
+      columns[i] = j;
+    }
+  }
+
+  max_rows = 0;
+  for (j = 0; j < num_entries; j++)
+  {
+    if ((entries[j].table == t) && (entries[j].rows > max_rows))
+    {
+      max_rows = entries[j].rows;
+    }
+  }
+  for (i = 0; i < num_columns; i++)
+  {
+    printf ("%s%s", i ? "," : "", schema->columns[columns[i]]);
+    values[i] = rstore_alloc (max_rows * sizeof (double));
+  }
+  printf ("\n");
+
+  for (j = 0; j < num_entries; j++)
+  {
+    entry = &entries[j];
+    if (entry->table != t)
+    {
+      continue;
+    }
+    if ((entry->segment < 0) || (entry->segment >= num_segments) ||
+        (entry->rows < 0))
+    {
+      rstore_fail ("corrupt results index entry of table", table);
+    }
+    fp = segment_fps[entry->segment];
+    if (fp == NULL)
+    {
+      sprintf (filename, "%s%.*s", dir, RSTORE_NAME_LEN,
+               segment_names[entry->segment]);
+      fp = fopen (filename, "rb");
+      if (fp == NULL)
+      {
+        rstore_fail ("unable to open", filename);
+      }
+      segment_fps[entry->segment] = fp;
+    }
+    for (i = 0; i < num_columns; i++)
+    {
+      if (fseek (fp, (long) (entry->offset +
+                             RSTORE_COLUMN_OFFSET (schema, entry->rows,
+                                                   columns[i])),
+                 SEEK_SET) ||
+          (fread (values[i], columns[i] < schema->num_ints ?
+                  sizeof (int) : sizeof (double), entry->rows, fp) !=
+           (size_t) entry->rows))
+      {
+        rstore_fail ("truncated results segment",
+                     segment_names[entry->segment]);
+      }
+    }
+    for (row = 0; row < entry->rows; row++)
+    {
+      for (i = 0; i < num_columns; i++)
+      {
+        if (i)
+        {
+          putchar (',');
+        }
+        if (columns[i] < schema->num_ints)
+        {
+          printf ("%d", ((int *) values[i])[row]);
+        }
+        else
+        {
+          printf ("%.15g", ((double *) values[i])[row]);
+        }
+      }
+      putchar ('\n');
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_alloc
+** PURPOSE:       malloc which exits on failure
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void *
+  rstore_alloc (size_t size)
+{
+  void *ptr;
+
+  ptr = malloc (size + 1);
+  if (ptr == NULL)
+  {
+    rstore_fail ("out of memory", "");
+  }
+  return ptr;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_fail
+** PURPOSE:       report an error and exit
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void
+  rstore_fail (char *msg, char *arg)
+{
+  fprintf (stderr, "rstore: %s %s\n", msg, arg);
+  exit (1);
+}
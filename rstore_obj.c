@@ -0,0 +1,496 @@
+/*******************************************************************************
+
+  MODULE:                   rstore_obj.c
+
+  CONTAINING SYSTEM:        SLEUTH-3r (based on SLEUTH Model 3.0 Beta)
+                            (Slope, Land-cover, Exclusion, Urbanization,
+                            Transportation, and Hillshade)
+                            also known as UGM 3.0 Beta (for Urban Growth Model)
+
+  VERSION:                  SLEUTH-3r [Includes Version D features]
+
+  REVISION DATE:            October 19, 2026
+
+  PURPOSE:
+
+     This module is a pseudo-object which writes the results tables of
+     the run (control_stats, avg, std_dev, coeff) to a columnar binary
+     store when WRITE_RESULTS_STORE is set in the scenario file, instead
+     of appending text lines to one file per table and process.
+
+  NOTES:
+
+     The layout of the segment and index files is described in
+     rstore_obj.h. The segment of this process stays open for the whole
+     run and rows are buffered per table, so a row costs a few stores
+     and a chunk of RSTORE_CHUNK_ROWS rows costs one fwrite. Tables are
+     numbered in the order this process defines them; rstore_MergeIndex
+     matches the tables of the segments by name.
+
+     rstore_Close must be called by every process before rank 0 calls
+     rstore_MergeIndex.
+
+  MODIFICATIONS:
+
+  TO DO:
+
+**************************************************************************/
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _MSC_VER
+  #include <unistd.h>
+#endif
+#include "globals.h"
+#include "scenario_obj.h"
+#include "ugm_macros.h"
+#include "rstore_obj.h"
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                      STATIC MEMORY FOR THIS OBJECT                        **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+typedef struct
+{
+  rstore_schema schema;
+  int rows;
+  int *ints;
+  double *reals;
+} rstore_table;
+
+static rstore_table tables[RSTORE_MAX_TABLES];
+static int num_tables;
+static FILE *segment_fp;
+
+/*****************************************************************************\
+*******************************************************************************
+**                                                                           **
+**                        STATIC FUNCTION PROTOTYPES                         **
+**                                                                           **
+*******************************************************************************
+\*****************************************************************************/
+static void rstore_flush (int table);
+static void rstore_write (void *ptr, size_t size, size_t count, FILE * fp);
+static int rstore_merge_schema (rstore_schema * merged, int *num_merged,
+                                rstore_schema * schema);
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_Init
+** PURPOSE:       open the segment of this process
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Does nothing unless WRITE_RESULTS_STORE is set.
+**
+**
+*/
+void
+  rstore_Init ()
+{
+  char func[] = "rstore_Init";
+  char filename[MAX_FILENAME_LEN];
+  int rank;
+
+  if (!scen_GetWriteResultsStoreFlag () || (segment_fp != NULL))
+  {
+    return;
+  }
+
+  sprintf (filename, "%sresults_pe_%u.bin", scen_GetOutputDir (), glb_mype);
+  FILE_OPEN (segment_fp, filename, "wb");
+  rank = glb_mype;
+  rstore_write (RSTORE_SEGMENT_MAGIC, 1, RSTORE_MAGIC_LEN, segment_fp);
+  rstore_write (&rank, sizeof (int), 1, segment_fp);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_MemoryLog
+** PURPOSE:       log memory map to FILE* fp
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  rstore_MemoryLog (FILE * fp)
+{
+  LOG_MEM (fp, &tables[0], sizeof (rstore_table), RSTORE_MAX_TABLES);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_DefineTable
+** PURPOSE:       declare a table and return its number
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The first num_ints columns hold ints, the others doubles.
+**                Defining a table again returns the number it already has.
+**
+*/
+int
+  rstore_DefineTable (char *name, int num_columns, char *columns[],
+                      int num_ints)
+{
+  char func[] = "rstore_DefineTable";
+  rstore_chunk_hdr hdr;
+  rstore_table *table;
+  int i;
+
+  if (segment_fp == NULL)
+  {
+    sprintf (msg_buf, "results store is not open (table %s)", name);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  for (i = 0; i < num_tables; i++)
+  {
+    if (!strcmp (tables[i].schema.name, name))
+    {
+      return i;
+    }
+  }
+  if ((num_tables == RSTORE_MAX_TABLES) ||
+      (num_columns > RSTORE_MAX_COLUMNS) ||
+      (num_ints < 0) || (num_ints > num_columns) ||
+      (strlen (name) >= RSTORE_NAME_LEN))
+  {
+    sprintf (msg_buf, "cannot define results table %s", name);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  table = &tables[num_tables];
+  memset (table, 0, sizeof (rstore_table));
+  strcpy (table->schema.name, name);
+  table->schema.num_columns = num_columns;
+  table->schema.num_ints = num_ints;
+  for (i = 0; i < num_columns; i++)
+  {
+    strncpy (table->schema.columns[i], columns[i], RSTORE_NAME_LEN - 1);
+  }
+  table->ints = malloc (RSTORE_CHUNK_ROWS * (num_ints + 1) * sizeof (int));
+  table->reals = malloc (RSTORE_CHUNK_ROWS * (num_columns - num_ints + 1) *
+                         sizeof (double));
+  if ((table->ints == NULL) || (table->reals == NULL))
+  {
+    sprintf (msg_buf, "Unable to allocate the rows of results table %s",
+             name);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  hdr.kind = RSTORE_SCHEMA_CHUNK;
+  hdr.table = num_tables;
+  hdr.count = num_columns;
+  hdr.num_ints = num_ints;
+  rstore_write (&hdr, sizeof (hdr), 1, segment_fp);
+  rstore_write (&table->schema, sizeof (rstore_schema), 1, segment_fp);
+
+  return num_tables++;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_AppendRow
+** PURPOSE:       add a row to a table
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   ints holds the num_ints int columns and reals the
+**                others, in schema order.
+**
+*/
+void
+  rstore_AppendRow (int table, int ints[], double reals[])
+{
+  rstore_table *t;
+  int i;
+
+  assert ((table >= 0) && (table < num_tables));
+  t = &tables[table];
+  for (i = 0; i < t->schema.num_ints; i++)
+  {
+    t->ints[i * RSTORE_CHUNK_ROWS + t->rows] = ints[i];
+  }
+  for (i = 0; i < t->schema.num_columns - t->schema.num_ints; i++)
+  {
+    t->reals[i * RSTORE_CHUNK_ROWS + t->rows] = reals[i];
+  }
+  t->rows++;
+  if (t->rows == RSTORE_CHUNK_ROWS)
+  {
+    rstore_flush (table);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_Close
+** PURPOSE:       write the buffered rows and close the segment
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  rstore_Close ()
+{
+  int i;
+
+  if (segment_fp == NULL)
+  {
+    return;
+  }
+  for (i = 0; i < num_tables; i++)
+  {
+    rstore_flush (i);
+    free (tables[i].ints);
+    free (tables[i].reals);
+  }
+  num_tables = 0;
+  fclose (segment_fp);
+  segment_fp = NULL;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_MergeIndex
+** PURPOSE:       write the index of the segments of every process
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Only the chunk headers are read; the segments themselves
+**                are left where they are.
+**
+*/
+void
+  rstore_MergeIndex ()
+{
+  char func[] = "rstore_MergeIndex";
+  char filename[MAX_FILENAME_LEN];
+  char segment_name[RSTORE_NAME_LEN];
+  char magic[RSTORE_MAGIC_LEN];
+  rstore_schema merged[RSTORE_MAX_TABLES];
+  rstore_schema schema;
+  rstore_chunk_hdr hdr;
+  rstore_index_entry *entries;
+  int global[RSTORE_MAX_TABLES];
+  long long row_bytes[RSTORE_MAX_TABLES];
+  int num_merged;
+  int num_entries;
+  int max_entries;
+  int rank;
+  int header[4];
+  FILE *fp;
+
+  if (!scen_GetWriteResultsStoreFlag ())
+  {
+    return;
+  }
+
+  num_merged = 0;
+  num_entries = 0;
+  max_entries = 1024;
+  entries = malloc (max_entries * sizeof (rstore_index_entry));
+  if (entries == NULL)
+  {
+    sprintf (msg_buf, "Unable to allocate the results index");
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  for (rank = 0; rank < glb_npes; rank++)
+  {
+    sprintf (filename, "%sresults_pe_%u.bin", scen_GetOutputDir (), rank);
+    FILE_OPEN (fp, filename, "rb");
+    if ((fread (magic, 1, RSTORE_MAGIC_LEN, fp) != RSTORE_MAGIC_LEN) ||
+        memcmp (magic, RSTORE_SEGMENT_MAGIC, RSTORE_MAGIC_LEN) ||
+        (fread (header, sizeof (int), 1, fp) != 1))
+    {
+      sprintf (msg_buf, "%s is not a results segment", filename);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    while (fread (&hdr, sizeof (hdr), 1, fp) == 1)
+    {
+      if ((hdr.table < 0) || (hdr.table >= RSTORE_MAX_TABLES))
+      {
+        sprintf (msg_buf, "%s: bad table %d", filename, hdr.table);
+        LOG_ERROR (msg_buf);
+        EXIT (1);
+      }
+      if (hdr.kind == RSTORE_SCHEMA_CHUNK)
+      {
+        if (fread (&schema, sizeof (schema), 1, fp) != 1)
+        {
+          sprintf (msg_buf, "%s is truncated", filename);
+          LOG_ERROR (msg_buf);
+          EXIT (1);
+        }
+        global[hdr.table] = rstore_merge_schema (merged, &num_merged, &schema);
+        row_bytes[hdr.table] = (long long) schema.num_ints * 4 +
+          (long long) (schema.num_columns - schema.num_ints) * 8;
+        continue;
+      }
+      if (num_entries == max_entries)
+      {
+        max_entries *= 2;
+        entries = realloc (entries, max_entries * sizeof (rstore_index_entry));
+        if (entries == NULL)
+        {
+          sprintf (msg_buf, "Unable to allocate the results index");
+          LOG_ERROR (msg_buf);
+          EXIT (1);
+        }
+      }
+      entries[num_entries].segment = rank;
+      entries[num_entries].table = global[hdr.table];
+      entries[num_entries].rows = hdr.count;
+      entries[num_entries].unused = 0;
+      entries[num_entries].offset = ftell (fp);
+      num_entries++;
+      fseek (fp, (long) (row_bytes[hdr.table] * hdr.count), SEEK_CUR);
+    }
+    fclose (fp);
+  }
+
+  sprintf (filename, "%s%s", scen_GetOutputDir (), RSTORE_INDEX_FILE);
+  FILE_OPEN (fp, filename, "wb");
+  header[0] = glb_npes;
+  header[1] = num_merged;
+  header[2] = num_entries;
+  header[3] = 0;
+  rstore_write (RSTORE_INDEX_MAGIC, 1, RSTORE_MAGIC_LEN, fp);
+  rstore_write (header, sizeof (int), 4, fp);
+  for (rank = 0; rank < glb_npes; rank++)
+  {
+    memset (segment_name, 0, RSTORE_NAME_LEN);
+    sprintf (segment_name, "results_pe_%u.bin", rank);
+    rstore_write (segment_name, 1, RSTORE_NAME_LEN, fp);
+  }
+  rstore_write (merged, sizeof (rstore_schema), num_merged, fp);
+  rstore_write (entries, sizeof (rstore_index_entry), num_entries, fp);
+  fclose (fp);
+  free (entries);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_flush
+** PURPOSE:       write the buffered rows of a table as one data chunk
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void
+  rstore_flush (int table)
+{
+  rstore_chunk_hdr hdr;
+  rstore_table *t;
+  int i;
+
+  t = &tables[table];
+  if (t->rows == 0)
+  {
+    return;
+  }
+  hdr.kind = RSTORE_DATA_CHUNK;
+  hdr.table = table;
+  hdr.count = t->rows;
+  hdr.num_ints = t->schema.num_ints;
+  rstore_write (&hdr, sizeof (hdr), 1, segment_fp);
+  for (i = 0; i < t->schema.num_ints; i++)
+  {
+    rstore_write (&t->ints[i * RSTORE_CHUNK_ROWS], sizeof (int), t->rows,
+                  segment_fp);
+  }
+  for (i = 0; i < t->schema.num_columns - t->schema.num_ints; i++)
+  {
+    rstore_write (&t->reals[i * RSTORE_CHUNK_ROWS], sizeof (double), t->rows,
+                  segment_fp);
+  }
+  t->rows = 0;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_write
+** PURPOSE:       fwrite which exits on failure
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+static void
+  rstore_write (void *ptr, size_t size, size_t count, FILE * fp)
+{
+  char func[] = "rstore_write";
+
+  if (fwrite (ptr, size, count, fp) != count)
+  {
+    sprintf (msg_buf, "Unable to write the results store: %s",
+             strerror (errno));
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: rstore_merge_schema
+** PURPOSE:       return the merged number of a segment table
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Tables are matched by name; a table of the same name
+**                must have the same columns in every segment.
+**
+*/
+static int
+  rstore_merge_schema (rstore_schema * merged, int *num_merged,
+                       rstore_schema * schema)
+{
+  char func[] = "rstore_merge_schema";
+  int i;
+
+  for (i = 0; i < *num_merged; i++)
+  {
+    if (!strcmp (merged[i].name, schema->name))
+    {
+      if (memcmp (&merged[i], schema, sizeof (rstore_schema)))
+      {
+        sprintf (msg_buf, "results table %s differs between segments",
+                 schema->name);
+        LOG_ERROR (msg_buf);
+        EXIT (1);
+      }
+      return i;
+    }
+  }
+  if (*num_merged == RSTORE_MAX_TABLES)
+  {
+    sprintf (msg_buf, "too many results tables");
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  merged[*num_merged] = *schema;
+  return (*num_merged)++;
+}
@@ -0,0 +1,77 @@
+#ifndef RSTORE_OBJ_H
+#define RSTORE_OBJ_H
+#include <stdio.h>
+#include "ugm_defines.h"
+
+/*
+ *
+ * The results store keeps the tables of a run (control_stats, avg,
+ * std_dev, coeff) as typed columns instead of text lines. Each process
+ * appends to its own segment, results_pe_<rank>.bin, which starts with
+ * RSTORE_SEGMENT_MAGIC and the rank and is then a sequence of chunks:
+ *
+ *   schema chunk: rstore_chunk_hdr, rstore_schema
+ *   data chunk:   rstore_chunk_hdr, then every int column (count int32
+ *                 values each), then every double column (count doubles
+ *                 each)
+ *
+ * The first num_ints columns of a table are int32, the others doubles.
+ * rstore_MergeIndex writes RSTORE_INDEX_FILE: RSTORE_INDEX_MAGIC, the
+ * number of segments, tables and chunks, the segment file names, the
+ * merged table schemas and one rstore_index_entry per data chunk, so a
+ * reader seeks straight to the columns it wants (see rstore.c).
+ *
+ * Values are in the byte order of the machine that wrote them.
+ *
+ */
+#define RSTORE_SEGMENT_MAGIC "SLRSSEG1"
+#define RSTORE_INDEX_MAGIC "SLRSIDX1"
+#define RSTORE_MAGIC_LEN 8
+#define RSTORE_INDEX_FILE "results.idx"
+#define RSTORE_NAME_LEN 32
+#define RSTORE_MAX_TABLES 16
+#define RSTORE_MAX_COLUMNS 32
+#define RSTORE_CHUNK_ROWS 4096
+
+#define RSTORE_SCHEMA_CHUNK 1
+#define RSTORE_DATA_CHUNK 2
+
+typedef struct
+{
+  int kind;
+  int table;
+  int count;
+  int num_ints;
+} rstore_chunk_hdr;
+
+typedef struct
+{
+  char name[RSTORE_NAME_LEN];
+  int num_columns;
+  int num_ints;
+  char columns[RSTORE_MAX_COLUMNS][RSTORE_NAME_LEN];
+} rstore_schema;
+
+typedef struct
+{
+  int segment;
+  int table;
+  int rows;
+  int unused;
+  long long offset;
+} rstore_index_entry;
+
+#define RSTORE_COLUMN_OFFSET(schema,rows,column)                         \
+  ((column) < (schema)->num_ints ?                                       \
+   (long long) (column) * (rows) * 4 :                                   \
+   (long long) (schema)->num_ints * (rows) * 4 +                         \
+   (long long) ((column) - (schema)->num_ints) * (rows) * 8)
+
+void rstore_Init ();
+void rstore_MemoryLog (FILE * fp);
+int rstore_DefineTable (char *name, int num_columns, char *columns[],
+                        int num_ints);
+void rstore_AppendRow (int table, int ints[], double reals[]);
+void rstore_Close ();
+void rstore_MergeIndex ();
+#endif
@@ -1563,6 +1563,227 @@ BOOLEAN
   return FALSE;
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetPackedUrbanGridFlag
+** PURPOSE:       return packed urban grid flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetPackedUrbanGridFlag ()
+{
+  return scenario.packed_urban_grid;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetUrbanFrontierFlag
+** PURPOSE:       return urban frontier flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetUrbanFrontierFlag ()
+{
+  return scenario.urban_frontier;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetUrbanizeAcceptanceGridFlag
+** PURPOSE:       return the urbanize acceptance grid flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetUrbanizeAcceptanceGridFlag ()
+{
+  return scenario.urbanize_acceptance_grid;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetSpontaneousSamplingFlag
+** PURPOSE:       return the spontaneous growth sampling flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetSpontaneousSamplingFlag ()
+{
+  return scenario.spontaneous_sampling;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetTiledSpreadFlag
+** PURPOSE:       return the tiled spread flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetTiledSpreadFlag ()
+{
+  return scenario.tiled_spread;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetBitSlicedEnsembleFlag
+** PURPOSE:       return the bit-sliced ensemble flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetBitSlicedEnsembleFlag ()
+{
+  return scenario.bit_sliced_ensemble;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetCumulateMemoryMB
+** PURPOSE:       return the memory budget of the cumulate grids in MB
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+  scen_GetCumulateMemoryMB ()
+{
+  return scenario.cumulate_memory_mb;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetOutputWriterThreads
+** PURPOSE:       return the number of image writer threads
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+  scen_GetOutputWriterThreads ()
+{
+  return scenario.output_writer_threads;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetOutputQueueMB
+** PURPOSE:       return the memory budget of the image output queue
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+int
+  scen_GetOutputQueueMB ()
+{
+  return scenario.output_queue_mb;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetWriteGrowLogFlag
+** PURPOSE:       return the flag to dump every statistics record
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetWriteGrowLogFlag ()
+{
+  return scenario.write_grow_log_files;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetWriteResultsStoreFlag
+** PURPOSE:       results tables go to the binary results store
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetWriteResultsStoreFlag ()
+{
+  return scenario.write_results_store;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetSparseDeltatronFlag
+** PURPOSE:       keep the deltatrons as a sparse active set
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetSparseDeltatronFlag ()
+{
+  return scenario.sparse_deltatron;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: scen_GetIndexedDeltatronCentersFlag
+** PURPOSE:       return the indexed deltatron centers flag
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+BOOLEAN
+  scen_GetIndexedDeltatronCentersFlag ()
+{
+  return scenario.indexed_deltatron_centers;
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: scen_GetDeltatronColorCount
@@ -1736,6 +1957,15 @@ void
 #endif
   wgrid_SetWGridCount (scenario.num_working_grids);
 
+  if (scenario.monte_carlo_iterations > ACCUM_MAX)
+  {
+    sprintf (msg_buf,
+             "MONTE_CARLO_ITERATIONS=%d is more than %d (build with -DACCUM_32)",
+             scenario.monte_carlo_iterations, ACCUM_MAX);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
   scen_open_log ();
   FUNC_END;
 }
@@ -2419,6 +2649,134 @@ static void
             scen_process_user_color (object_ptr);
         }
 
+        else if (!strcmp (keyword, "PACKED_URBAN_GRID(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.packed_urban_grid = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.packed_urban_grid = 1;
+          }
+        }
+        else if (!strcmp (keyword, "URBAN_FRONTIER(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.urban_frontier = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.urban_frontier = 1;
+          }
+        }
+        else if (!strcmp (keyword, "URBANIZE_ACCEPTANCE_GRID(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.urbanize_acceptance_grid = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.urbanize_acceptance_grid = 1;
+          }
+        }
+        else if (!strcmp (keyword, "SPONTANEOUS_SAMPLING(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.spontaneous_sampling = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.spontaneous_sampling = 1;
+          }
+        }
+        else if (!strcmp (keyword, "TILED_SPREAD(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.tiled_spread = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.tiled_spread = 1;
+          }
+        }
+        else if (!strcmp (keyword, "BIT_SLICED_ENSEMBLE(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.bit_sliced_ensemble = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.bit_sliced_ensemble = 1;
+          }
+        }
+        else if (!strcmp (keyword, "CUMULATE_MEMORY_MB"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          scenario.cumulate_memory_mb = atoi (object_ptr);
+        }
+        else if (!strcmp (keyword, "OUTPUT_WRITER_THREADS"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          scenario.output_writer_threads = atoi (object_ptr);
+        }
+        else if (!strcmp (keyword, "OUTPUT_QUEUE_MB"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          scenario.output_queue_mb = atoi (object_ptr);
+        }
+        else if (!strcmp (keyword, "WRITE_GROW_LOG_FILES(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.write_grow_log_files = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.write_grow_log_files = 1;
+          }
+        }
+        else if (!strcmp (keyword, "WRITE_RESULTS_STORE(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.write_results_store = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.write_results_store = 1;
+          }
+        }
+        else if (!strcmp (keyword, "SPARSE_DELTATRON(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.sparse_deltatron = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.sparse_deltatron = 1;
+          }
+        }
+        else if (!strcmp (keyword, "INDEXED_DELTATRON_CENTERS(YES/NO)"))
+        {
+          object_ptr = strtok (NULL, " \n");
+          util_trim (object_ptr);
+          util_AllCAPS (object_ptr);
+          scenario.indexed_deltatron_centers = 0;
+          if (!strcmp (object_ptr, "YES"))
+          {
+            scenario.indexed_deltatron_centers = 1;
+          }
+        }
 		/*VerD*/
 
         else if (!strcmp (keyword, "AUX_DIFFUSION_COEFF"))
@@ -2690,6 +3048,19 @@ void
   fprintf (fp, "scenario.deltatron_aging_window.year2 = %d\n",
            scenario.deltatron_aging_window.year2);
 
+  fprintf (fp, "scenario.packed_urban_grid = %u\n", scenario.packed_urban_grid);
+  fprintf (fp, "scenario.urban_frontier = %u\n", scenario.urban_frontier);
+  fprintf (fp, "scenario.urbanize_acceptance_grid = %u\n", scenario.urbanize_acceptance_grid);
+  fprintf (fp, "scenario.spontaneous_sampling = %u\n", scenario.spontaneous_sampling);
+  fprintf (fp, "scenario.tiled_spread = %u\n", scenario.tiled_spread);
+  fprintf (fp, "scenario.bit_sliced_ensemble = %u\n", scenario.bit_sliced_ensemble);
+  fprintf (fp, "scenario.cumulate_memory_mb = %d\n", scenario.cumulate_memory_mb);
+  fprintf (fp, "scenario.output_writer_threads = %d\n", scenario.output_writer_threads);
+  fprintf (fp, "scenario.output_queue_mb = %d\n", scenario.output_queue_mb);
+  fprintf (fp, "scenario.write_grow_log_files = %u\n", scenario.write_grow_log_files);
+  fprintf (fp, "scenario.write_results_store = %u\n", scenario.write_results_store);
+  fprintf (fp, "scenario.sparse_deltatron = %u\n", scenario.sparse_deltatron);
+  fprintf (fp, "scenario.indexed_deltatron_centers = %u\n", scenario.indexed_deltatron_centers);
 
   /*VerD*/
 
@@ -109,6 +109,19 @@ typedef struct
   print_window_t deltatron_aging_window;
   int deltatron_color[256];
   int deltatron_color_count;
+  BOOLEAN packed_urban_grid;
+  BOOLEAN urban_frontier;
+  BOOLEAN urbanize_acceptance_grid;
+  BOOLEAN spontaneous_sampling;
+  BOOLEAN tiled_spread;
+  BOOLEAN bit_sliced_ensemble;
+  int cumulate_memory_mb;
+  int output_writer_threads;
+  int output_queue_mb;
+  BOOLEAN write_grow_log_files;
+  BOOLEAN write_results_store;
+  BOOLEAN sparse_deltatron;
+  BOOLEAN indexed_deltatron_centers;
 } scenario_info;
 #endif
 
@@ -209,5 +222,18 @@ char* scen_GetLanduseClassName (int);
 char* scen_GetLanduseClassType (int);
 int scen_GetLanduseClassColor (int);
 int scen_GetLanduseClassGrayscale (int i);
+BOOLEAN scen_GetIndexedDeltatronCentersFlag ();
+BOOLEAN scen_GetSparseDeltatronFlag ();
+BOOLEAN scen_GetWriteResultsStoreFlag ();
+BOOLEAN scen_GetWriteGrowLogFlag ();
+int scen_GetOutputQueueMB ();
+int scen_GetOutputWriterThreads ();
+int scen_GetCumulateMemoryMB ();
+BOOLEAN scen_GetBitSlicedEnsembleFlag ();
+BOOLEAN scen_GetTiledSpreadFlag ();
+BOOLEAN scen_GetSpontaneousSamplingFlag ();
+BOOLEAN scen_GetUrbanizeAcceptanceGridFlag ();
+BOOLEAN scen_GetUrbanFrontierFlag ();
+BOOLEAN scen_GetPackedUrbanGridFlag ();
 #endif
 
@@ -45,6 +45,7 @@
 #include "proc_obj.h"
 #include "scenario_obj.h"
 #include "stats_obj.h"
+#include "bgrid_obj.h"
 
 /*VerD*/
 extern float aux_diffusion_coeff;
@@ -65,6 +66,8 @@ float road_growth_diffusion_coefficient;
 #define SPREAD_MODULE
 #define SWGHT_TYPE float
 #define SLOPE_WEIGHT_ARRAY_SZ 256
+#define ACCEPT_SCALE 65536
+#define ACCEPT_VALUE(p) ((int) ((p) * ACCEPT_SCALE + 0.5))
 
 /***                          D.D. July 28, 2006               (Begin)     ***/
 #define WCOL(rr,kk)  rpocol_ptr[rporow_ptrIdx[rr]+kk]
@@ -89,33 +92,83 @@ float road_growth_diffusion_coefficient;
 /***                          D.D. July 28, 2006               (Begin)      **/
 /*** "int *" changed to "short *" 8/10/2006                                 **/
 /*** "short *" corrected back to "int *" for rporow_ptrIdx" 8/14/2006       **/
-  static short *rporow_ptrNum;
-  static short *rporow_ptrMin;
-  static short *rporow_ptrMax;
+  static COORD_TYPE *rporow_ptrNum;
+  static COORD_TYPE *rporow_ptrMin;
+  static COORD_TYPE *rporow_ptrMax;
   static int   *rporow_ptrIdx;
-  static short *rpocol_ptr;
+  static COORD_TYPE *rpocol_ptr;
   static int tfoundN, tfoundRow, tfoundCol;
   static int  foundN,  foundRow,  foundCol;
 /*******************          D.D. July 28, 2006      (End)  ******************/
 
 /***  D. Donato  Aug. 14, 2006  Moved to module level from spr_phase5       **/
   static int    growth_count;
-  static short *growth_row;
-  static short *growth_col;
+  static COORD_TYPE *growth_row;
+  static COORD_TYPE *growth_col;
   
   static int road_expansion_count;
   static int *road_expansion_row;
   static int *road_expansion_col;
 
+/* Uniform-grid spatial hash over the road expansion pixels (see spr_build_new_road) */
+  static int *road_expansion_head;
+  static int *road_expansion_next;
+  static int road_expansion_bucket_rows;
+  static int road_expansion_bucket_cols;
+
 /* The following two lines were replaced by D. Donato on 06/21/2006
 ****  D. Donato  Aug. 14, 2006                                              **/
 
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
-  static short *zgrwth_row;
-  static short *zgrwth_col;
+  static COORD_TYPE *zgrwth_row;
+  static COORD_TYPE *zgrwth_col;
   static int    zgrwth_count;
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
 
+/* Urban frontier: interior urban pixels with 2 to 7 urban neighbors (see spr_BuildUrbanFrontier) */
+  static COORD_TYPE *frontier_row;
+  static COORD_TYPE *frontier_col;
+  static PIXEL *frontier_flag;
+  static int    frontier_count;
+
+/* Neighbor offsets in util_get_next_neighbor order, and road neighbor masks:
+   bit k is set when neighbor k is a road pixel (see spr_BuildRoadNghbrMask) */
+  static PIXEL *road_nghbr_mask;
+  static int next_nghbr_row[8] = {-1, 0, 1, 1, 1, 0, -1, -1};
+  static int next_nghbr_col[8] = {-1, -1, -1, 0, 1, 1, 1, 0};
+
+/* Urbanize acceptance grid and the slope weights it was built from (see
+   spr_update_accept_grid); accept_grid is NULL when the mode is off */
+  static unsigned short *accept_grid;
+  static SWGHT_TYPE accept_swght[SLOPE_WEIGHT_ARRAY_SZ];
+  static BOOLEAN accept_swght_set = FALSE;
+
+/* Tiled spread: one record per SPREAD_TILE_SIZE square tile, holding its
+   random stream and the counts it gathers privately (see spr_tiled_spread) */
+  typedef struct
+  {
+    int row0;
+    int col0;
+    int nrows;
+    int ncols;
+    RANDOM_SEED_TYPE seed;
+    int grow_count;
+    int defer_count;
+    int z_count;
+    int sng;
+    int sdc;
+    int og;
+    long successes;
+    long z_failure;
+    long delta_failure;
+    long slope_failure;
+    long excluded_failure;
+  } spr_tile_info;
+
+  static spr_tile_info *tiles;
+  static int tile_count;
+  static int tile_cols;
+
 /*****************************************************************************\
 *******************************************************************************
 **                                                                           **
@@ -129,20 +182,20 @@ static void
 static void
     spr_phase1n3 (COEFF_TYPE diffusion_coefficient,          /* IN     */
                   COEFF_TYPE breed_coefficient,              /* IN     */
-                  GRID_P z,                                  /* IN     */
-                  GRID_P delta,                              /* IN/OUT */
-                  GRID_P slp,                                /* IN     */
-                  GRID_P excld,                              /* IN     */
+                  grid_view * z,                             /* IN     */
+                  grid_view * delta,                         /* IN/OUT */
+                  grid_view * slp,                           /* IN     */
+                  grid_view * excld,                         /* IN     */
                   SWGHT_TYPE * swght,                        /* IN     */
                   int *sng,                                  /* IN/OUT */
                   int *sdc);                                 /* IN/OUT */
 
 static void
     spr_phase4 (COEFF_TYPE spread_coefficient,               /* IN     */
-                GRID_P z,                                    /* IN     */
-                GRID_P excld,                                /* IN     */
-                GRID_P delta,                                /* IN/OUT */
-                GRID_P slp,                                  /* IN     */
+                grid_view * z,                               /* IN     */
+                grid_view * excld,                           /* IN     */
+                grid_view * delta,                           /* IN/OUT */
+                grid_view * slp,                             /* IN     */
                 SWGHT_TYPE * swght,                          /* IN     */
                 int *og);                                    /* IN/OUT */
 
@@ -151,10 +204,10 @@ static void
     spr_phase5 (COEFF_TYPE road_gravity,                     /* IN     */
                 COEFF_TYPE diffusion_coefficient,            /* IN     */
                 COEFF_TYPE breed_coefficient,                /* IN     */
-                GRID_P z,                                    /* IN     */
-                GRID_P delta,                                /* IN/OUT */
-                GRID_P slp,                                  /* IN     */
-                GRID_P excld,                                /* IN     */
+                grid_view * z,                               /* IN     */
+                grid_view * delta,                           /* IN/OUT */
+                grid_view * slp,                             /* IN     */
+                grid_view * excld,                           /* IN     */
                 GRID_P roads,                                /* IN     */
                 SWGHT_TYPE * swght,                          /* IN     */
                 int *rt);                                    /* IN/OUT */
@@ -165,8 +218,8 @@ static void
 static void
     spr_get_slp_weights (int array_size,                     /* IN     */
                          SWGHT_TYPE * lut);                  /* OUT    */
-static BOOLEAN spr_road_search (short i_grwth_center,        /* IN     */
-                                short j_grwth_center,        /* IN     */
+static BOOLEAN spr_road_search (int i_grwth_center,          /* IN     */
+                                int j_grwth_center,          /* IN     */
                                 int *i_road,                 /* OUT    */
                                 int *j_road,                 /* OUT    */
                                 int max_search_index,        /* IN     */
@@ -183,15 +236,16 @@ static
                               int j,                         /* IN     */
                               int *i_nghbr,                  /* OUT    */
                               int *j_nghbr,                  /* OUT    */
-                              GRID_P z,                      /* IN     */
-                              GRID_P delta,                  /* IN     */
-                              GRID_P slp,                    /* IN     */
-                              GRID_P excld,                  /* IN     */
+                              grid_view * z,                 /* IN     */
+                              grid_view * delta,             /* IN     */
+                              grid_view * slp,               /* IN     */
+                              grid_view * excld,             /* IN     */
                               SWGHT_TYPE * swght,            /* IN     */
                               PIXEL pixel_value,             /* IN     */
                               int *stat);                    /* OUT    */
 static
-  void spr_get_neighbor (int i_in,                           /* IN     */
+  void spr_get_neighbor (grid_view * grid,                   /* IN     */
+                         int i_in,                           /* IN     */
                          int j_in,                           /* IN     */
                          int *i_out,                         /* OUT    */
                          int *j_out);                        /* OUT    */
@@ -199,14 +253,82 @@ static
 static BOOLEAN
     spr_urbanize (int row,                                   /* IN     */
                   int col,                                   /* IN     */
-                  GRID_P z,                                  /* IN     */
-                  GRID_P delta,                              /* IN     */
-                  GRID_P slp,                                /* IN     */
-                  GRID_P excld,                              /* IN     */
+                  grid_view * z,                             /* IN     */
+                  grid_view * delta,                         /* IN     */
+                  grid_view * slp,                           /* IN     */
+                  grid_view * excld,                         /* IN     */
                   SWGHT_TYPE * swght,                        /* IN     */
                   PIXEL pixel_value,                         /* IN     */
                   int *stat);                                /* OUT    */
 
+static BOOLEAN
+    spr_closest_road_expansion (int cellRow,                 /* IN     */
+                                int cellCol,                 /* IN     */
+                                BOOLEAN check_range,         /* IN     */
+                                int connected_road_row,      /* IN     */
+                                int connected_road_col,      /* IN     */
+                                int *min_distance,           /* IN/OUT */
+                                int *road_row,               /* OUT    */
+                                int *road_col);              /* OUT    */
+
+static void
+    spr_tiled_spread (COEFF_TYPE diffusion_coefficient,      /* IN     */
+                      COEFF_TYPE breed_coefficient,          /* IN     */
+                      COEFF_TYPE spread_coefficient,         /* IN     */
+                      grid_view * z,                         /* IN     */
+                      grid_view * delta,                     /* IN/OUT */
+                      grid_view * slp,                       /* IN     */
+                      grid_view * excld,                     /* IN     */
+                      SWGHT_TYPE * swght,                    /* IN     */
+                      int *sng,                              /* IN/OUT */
+                      int *sdc,                              /* IN/OUT */
+                      int *og);                              /* IN/OUT */
+
+static void
+    spr_tile_grow (spr_tile_info * tile,                     /* IN/OUT */
+                   int tile_id,                              /* IN     */
+                   int attempts,                             /* IN     */
+                   COEFF_TYPE breed_coefficient,             /* IN     */
+                   COEFF_TYPE spread_coefficient,            /* IN     */
+                   grid_view * z,                            /* IN     */
+                   grid_view * delta,                        /* IN/OUT */
+                   grid_view * slp,                          /* IN     */
+                   grid_view * excld,                        /* IN     */
+                   SWGHT_TYPE * swght);                      /* IN     */
+
+static BOOLEAN
+    spr_tile_urbanize (spr_tile_info * tile,                 /* IN/OUT */
+                       int tile_id,                          /* IN     */
+                       int row,                              /* IN     */
+                       int col,                              /* IN     */
+                       grid_view * z,                        /* IN     */
+                       grid_view * delta,                    /* IN/OUT */
+                       grid_view * slp,                      /* IN     */
+                       grid_view * excld,                    /* IN     */
+                       SWGHT_TYPE * swght,                   /* IN     */
+                       PIXEL pixel_value,                    /* IN     */
+                       PIXEL * claims);                      /* IN/OUT */
+
+static void
+    spr_update_accept_grid (GRID_P slp,                      /* IN     */
+                            GRID_P excld,                    /* IN     */
+                            SWGHT_TYPE * swght);             /* IN     */
+
+static void
+    spr_road_nghbr_update (GRID_P roads,                     /* IN     */
+                           int row,                          /* IN     */
+                           int col);                         /* IN     */
+
+static int
+    spr_count_urban_nghbrs (grid_view * z,                   /* IN     */
+                            int row,                         /* IN     */
+                            int col);                        /* IN     */
+
+static void
+    spr_frontier_add (grid_view * z,                         /* IN     */
+                      int row,                               /* IN     */
+                      int col);                              /* IN     */
+
 static COEFF_TYPE
     spr_GetDiffusionValue (COEFF_TYPE diffusion_coeff);      /* IN    */
 static COEFF_TYPE
@@ -239,10 +361,10 @@ char spread_c_sccs_id[] = "@(#)spread.c	1.427	12/4/00";
 static void
   spr_phase1n3 (COEFF_TYPE diffusion_coefficient,            /* IN     */
                 COEFF_TYPE breed_coefficient,                /* IN     */
-                GRID_P z,                                    /* IN     */
-                GRID_P delta,                                /* IN/OUT */
-                GRID_P slp,                                  /* IN     */
-                GRID_P excld,                                /* IN     */
+                grid_view * z,                               /* IN     */
+                grid_view * delta,                           /* IN/OUT */
+                grid_view * slp,                             /* IN     */
+                grid_view * excld,                           /* IN     */
                 SWGHT_TYPE * swght,                          /* IN     */
                 int *sng,                                    /* IN/OUT */
                 int *sdc)                                    /* IN/OUT */
@@ -256,6 +378,13 @@ static void
   int count;
   int tries;
   int max_tries;
+  int attempts;
+  int candidate;
+  int candidate_count;
+  COORD_TYPE *candidate_row;
+  COORD_TYPE *candidate_col;
+  double expected_attempts;
+  BOOLEAN sampling;
   COEFF_TYPE diffusion_value;
   BOOLEAN urbanized;
 
@@ -273,12 +402,49 @@ static void
   assert (sdc != NULL);
 
   diffusion_value = spr_GetDiffusionValue (diffusion_coefficient);
-  for (k = 0; k < 1 + (int) diffusion_value; k++)
+  attempts = 1 + (int) diffusion_value;
+
+  /*
+   *
+   * WHEN SAMPLING FROM THE CANDIDATE INDEX, ONLY THE SHARE OF THE
+   * UNIFORM ATTEMPTS WHICH WOULD HAVE LANDED ON A CANDIDATE IS
+   * MADE (ROUNDED AT RANDOM TO KEEP THE EXPECTED COUNT). THE OTHER
+   * ATTEMPTS COULD NEVER HAVE URBANIZED A PIXEL.
+   *
+   */
+  sampling = scen_GetSpontaneousSamplingFlag ();
+  candidate_count = 0;
+  candidate_row = NULL;
+  candidate_col = NULL;
+  if (sampling)
   {
-    i = RANDOM_ROW;
-    j = RANDOM_COL;
+    candidate_count = igrid_GetSpnPixCount ();
+    candidate_row = igrid_GetSpnPixRowPtr ();
+    candidate_col = igrid_GetSpnPixColPtr ();
+    expected_attempts = (double) attempts * candidate_count /
+      mem_GetTotalPixels ();
+    attempts = (int) expected_attempts;
+    if (RANDOM_FLOAT < expected_attempts - attempts)
+    {
+      attempts++;
+    }
+  }
 
-    if (INTERIOR_PT (i, j))
+  for (k = 0; k < attempts; k++)
+  {
+    if (sampling)
+    {
+      candidate = RANDOM_INT (candidate_count);
+      i = candidate_row[candidate];
+      j = candidate_col[candidate];
+    }
+    else
+    {
+      i = RANDOM_INT (z->nrows);
+      j = RANDOM_INT (z->ncols);
+    }
+
+    if (GV_INTERIOR_PT (z, i, j))
     {
       if (spr_urbanize (i,                                     /* IN     */
                         j,                                     /* IN     */
@@ -339,10 +505,10 @@ static void
 */
 static void
   spr_phase4 (COEFF_TYPE spread_coefficient,                 /* IN     */
-              GRID_P z,                                      /* IN     */
-              GRID_P excld,                                  /* IN     */
-              GRID_P delta,                                  /* IN/OUT */
-              GRID_P slp,                                    /* IN     */
+              grid_view * z,                                 /* IN     */
+              grid_view * excld,                             /* IN     */
+              grid_view * delta,                             /* IN/OUT */
+              grid_view * slp,                               /* IN     */
               SWGHT_TYPE * swght,                            /* IN     */
               int *og)                                       /* IN/OUT */
 {
@@ -369,11 +535,56 @@ static void
   assert (swght != NULL);
   assert (og != NULL);
 
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = z->nrows;
+  ncols = z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
 
+  if (scen_GetUrbanFrontierFlag ())
+  {
+    /*
+     *
+     * LOOP OVER THE URBAN FRONTIER ONLY. PIXELS WHICH HAVE BECOME
+     * SURROUNDED SINCE THEY ENTERED THE FRONTIER ARE DROPPED
+     * WITHOUT DRAWING A RANDOM NUMBER.
+     *
+     */
+    i = 0;
+    while (i < frontier_count)
+    {
+      row = frontier_row[i];
+      col = frontier_col[i];
+      urb_count = spr_count_urban_nghbrs (z, row, col);
+      if (urb_count >= 8)
+      {
+        frontier_count--;
+        frontier_row[i] = frontier_row[frontier_count];
+        frontier_col[i] = frontier_col[frontier_count];
+        continue;
+      }
+      if (RANDOM_INT (101) < spread_coefficient)
+      {
+        pixel = RANDOM_INT (8);
+
+        row_nghbr = row + walkabout_row[pixel];
+        col_nghbr = col + walkabout_col[pixel];
+
+        spr_urbanize (row_nghbr,                             /* IN     */
+                      col_nghbr,                             /* IN     */
+                      z,                                     /* IN     */
+                      delta,                                 /* IN/OUT */
+                      slp,                                   /* IN     */
+                      excld,                                 /* IN     */
+                      swght,                                 /* IN     */
+                      PHASE4G,                               /* IN     */
+                      og);                                   /* IN/OUT */
+      }
+      i++;
+    }
+    FUNC_END;
+    return;
+  }
+
   /*
    *
    * LOOP OVER THE INTERIOR PIXELS LOOKING FOR URBAN FROM WHICH
@@ -404,7 +615,7 @@ static void
        * SPREAD COEFFICIENT TEST
        *
        */
-      if ((z[OFFSET (row, col)] > 0) &&
+      if ((GV_PIXEL (z, row, col) > 0) &&
           (RANDOM_INT (101) < spread_coefficient))
       {
         /*
@@ -413,7 +624,7 @@ static void
          * PIXEL ITSELF MUST BE URBAN (3)
          *
          */
-        urb_count = util_count_neighbors (z, row, col, GT, 0);
+        urb_count = spr_count_urban_nghbrs (z, row, col);
         if ((urb_count >= 2) && (urb_count < 8))
         {
           pixel = RANDOM_INT (8);
@@ -486,6 +697,104 @@ spr_compute_line(	int pointA_row,		/* IN */
 	FUNC_END;
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_BuildRoadNghbrMask
+** PURPOSE:       build the road neighbor mask of every pixel
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   called once per monte carlo run, after the road state grid
+**                has been copied from the seed road grid. spr_build_new_road
+**                keeps the masks current as new road pixels are drawn, so
+**                spr_road_walk can step along the roads without probing
+**                and bounds checking the eight neighbors.
+**
+*/
+void
+  spr_BuildRoadNghbrMask (GRID_P roads)                      /* IN     */
+{
+  int nrows;
+  int ncols;
+  int row;
+  int col;
+  int row_nghbr;
+  int col_nghbr;
+  int k;
+  PIXEL mask;
+
+  road_nghbr_mask = mem_GetRNMptr ();
+  nrows = igrid_GetNumRows ();
+  ncols = igrid_GetNumCols ();
+
+  for (row = 0; row < nrows; row++)
+  {
+    for (col = 0; col < ncols; col++)
+    {
+      mask = 0;
+      for (k = 0; k < 8; k++)
+      {
+        row_nghbr = row + next_nghbr_row[k];
+        col_nghbr = col + next_nghbr_col[k];
+        if ((row_nghbr >= 0) && (row_nghbr < nrows) &&
+            (col_nghbr >= 0) && (col_nghbr < ncols) &&
+            roads[OFFSET (row_nghbr, col_nghbr)])
+        {
+          mask |= (PIXEL) (1 << k);
+        }
+      }
+      road_nghbr_mask[OFFSET (row, col)] = mask;
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_road_nghbr_update
+** PURPOSE:       update the road neighbor masks around a modified pixel
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   neighbor k of (row,col) sees (row,col) as its neighbor
+**                (k + 4) % 8, whose bit is set or cleared according to
+**                the new road value of (row,col).
+**
+*/
+static void
+  spr_road_nghbr_update (GRID_P roads,                       /* IN     */
+                         int row,                            /* IN     */
+                         int col)                            /* IN     */
+{
+  int nrows;
+  int ncols;
+  int row_nghbr;
+  int col_nghbr;
+  int k;
+  PIXEL bit;
+
+  nrows = igrid_GetNumRows ();
+  ncols = igrid_GetNumCols ();
+
+  for (k = 0; k < 8; k++)
+  {
+    row_nghbr = row + next_nghbr_row[k];
+    col_nghbr = col + next_nghbr_col[k];
+    if ((row_nghbr >= 0) && (row_nghbr < nrows) &&
+        (col_nghbr >= 0) && (col_nghbr < ncols))
+    {
+      bit = (PIXEL) (1 << ((k + 4) % 8));
+      if (roads[OFFSET (row, col)])
+      {
+        road_nghbr_mask[OFFSET (row_nghbr, col_nghbr)] |= bit;
+      }
+      else
+      {
+        road_nghbr_mask[OFFSET (row_nghbr, col_nghbr)] &= (PIXEL) ~bit;
+      }
+    }
+  }
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: spr_build_new_road
@@ -526,8 +835,14 @@ spr_build_new_road(GRID_P road_ptr, int cellRow, int cellCol, int roadRow, int r
 		int y = roadLineColsPtr[i];
 
 		road_ptr[OFFSET(x, y)] = road_value;
+		spr_road_nghbr_update(road_ptr, x, y);
 		road_expansion_row[road_expansion_count] = x;
 		road_expansion_col[road_expansion_count] = y;
+
+		// chain the new pixel into its spatial hash bucket
+		int bucket = (x / ROAD_EXPANSION_BUCKET_SIZE) * road_expansion_bucket_cols + y / ROAD_EXPANSION_BUCKET_SIZE;
+		road_expansion_next[road_expansion_count] = road_expansion_head[bucket];
+		road_expansion_head[bucket] = road_expansion_count;
 		road_expansion_count++;
 	}
 	pgrid_SetRoadStatePixelCount(roadStatePixelCount + roadLinePixelCount);
@@ -572,6 +887,79 @@ spr_max_norm(int x0, int y0, int x1, int y1)
 	return max(abs(x1 - x0), abs(y1 - y0));
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_closest_road_expansion
+** PURPOSE:       find the closest road pixel built during the current year
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Only the spatial hash buckets overlapping the square of
+**                max norm radius (*min_distance - 1) around the cell are
+**                visited. A pixel replaces the current best one if it is
+**                strictly closer (and not the cell itself), ties going to the
+**                pixel built first, so the result is the same as a linear
+**                scan of the road expansion arrays.
+**
+*/
+static BOOLEAN
+spr_closest_road_expansion(int cellRow,		/* IN     */
+	int cellCol,								/* IN     */
+	BOOLEAN check_range,						/* IN     */
+	int connected_road_row,						/* IN     */
+	int connected_road_col,						/* IN     */
+	int *min_distance,							/* IN/OUT */
+	int *road_row,								/* OUT    */
+	int *road_col)								/* OUT    */
+{
+	int radius = (*min_distance) - 1;
+	int best_index = -1;
+	int best_distance = *min_distance;
+
+	if (radius < 1 || road_expansion_count == 0) {
+		return FALSE;
+	}
+
+	int brow_min = MAX(cellRow - radius, 0) / ROAD_EXPANSION_BUCKET_SIZE;
+	int brow_max = (cellRow + radius) / ROAD_EXPANSION_BUCKET_SIZE;
+	int bcol_min = MAX(cellCol - radius, 0) / ROAD_EXPANSION_BUCKET_SIZE;
+	int bcol_max = (cellCol + radius) / ROAD_EXPANSION_BUCKET_SIZE;
+	brow_max = MIN(brow_max, road_expansion_bucket_rows - 1);
+	bcol_max = MIN(bcol_max, road_expansion_bucket_cols - 1);
+
+	for (int brow = brow_min; brow <= brow_max; brow++) {
+		for (int bcol = bcol_min; bcol <= bcol_max; bcol++) {
+			for (int road_index = road_expansion_head[brow * road_expansion_bucket_cols + bcol];
+				road_index >= 0; road_index = road_expansion_next[road_index]) {
+				int roadRow = road_expansion_row[road_index];
+				int roadCol = road_expansion_col[road_index];
+				int distanceToNewRoad = spr_max_norm(roadRow, roadCol, cellRow, cellCol);
+
+				if (distanceToNewRoad == 0 || distanceToNewRoad > best_distance) {
+					continue;
+				}
+				if (distanceToNewRoad == best_distance && (best_index < 0 || road_index > best_index)) {
+					continue;
+				}
+				if (check_range && !spr_isInConnectionRange(cellRow, cellCol, connected_road_row, connected_road_col,
+					roadRow, roadCol)) {
+					continue;
+				}
+				best_index = road_index;
+				best_distance = distanceToNewRoad;
+			}
+		}
+	}
+
+	if (best_index < 0) {
+		return FALSE;
+	}
+	(*road_row) = road_expansion_row[best_index];
+	(*road_col) = road_expansion_col[best_index];
+	(*min_distance) = best_distance;
+	return TRUE;
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: spr_road_interconnection
@@ -738,25 +1126,8 @@ spr_road_interconnection(GRID_P roads,		/* IN  */
 		road_found = TRUE;
 		//check if there is any closer road pixel in this iteration's expanded road pixels
 		int minDistance = spr_max_norm(foundRow, foundCol, new_growth_cell_row, new_growth_cell_col);
-		for (int road_index = 0; road_index < road_expansion_count; road_index++) {
-			int roadRow = road_expansion_row[road_index];
-			int roadCol = road_expansion_col[road_index];
-			int distanceToNewRoad = spr_max_norm(roadRow, roadCol, new_growth_cell_row, new_growth_cell_col);
-			isInConnectionRange = spr_isInConnectionRange(new_growth_cell_row, new_growth_cell_col, connected_road_row, connected_road_col,
-				roadRow, roadCol);
-
-			if (minDistance > distanceToNewRoad && isInConnectionRange && distanceToNewRoad != 0) {
-
-				/*fprintf(stdout, "\nCloser new road pixel to (%i, %i) found, d(%i, %i)=%f instead of d(%i, %i)=%f \n",
-					i_grwth_center, j_grwth_center,
-					roadRow, roadCol, distanceToNewRoad,
-					foundRow, foundCol, minDistance);*/
-
-				foundRow = roadRow;
-				foundCol = roadCol;
-				minDistance = distanceToNewRoad;
-			}
-		}
+		spr_closest_road_expansion(new_growth_cell_row, new_growth_cell_col, TRUE,
+			connected_road_row, connected_road_col, &minDistance, &foundRow, &foundCol);
 		/*fprintf(stdout, "Found interconnection. row = %i, col = %i.\n", foundRow, foundCol);*/
 	}
 
@@ -801,10 +1172,10 @@ static void
   spr_phase5 (COEFF_TYPE road_gravity,                       /* IN     */
               COEFF_TYPE diffusion_coefficient,              /* IN     */
               COEFF_TYPE breed_coefficient,                  /* IN     */
-              GRID_P z,                                      /* IN     */
-              GRID_P delta,                                  /* IN/OUT */
-              GRID_P slp,                                    /* IN     */
-              GRID_P excld,                                  /* IN     */
+              grid_view * z,                                 /* IN     */
+              grid_view * delta,                             /* IN/OUT */
+              grid_view * slp,                               /* IN     */
+              grid_view * excld,                             /* IN     */
               GRID_P roads,                                  /* IN     */
               SWGHT_TYPE * swght,                            /* IN     */
               int *rt)                                       /* IN/OUT */
@@ -823,8 +1194,8 @@ static void
 /* D.D. The following two lines were restored July 24, 2006 */
 /* On 8/10/2006 "int *" was changed to "short *".           */
 /* On 8/14/2006 these two lines were moved to module level. **
-  short *growth_row;
-  short *growth_col;
+  COORD_TYPE *growth_row;
+  COORD_TYPE *growth_col;
 ** D. Donato 8/14/2006                                      */
 
 /* The following two lines were replaced by D. Donato on 06/21/2006
@@ -871,8 +1242,8 @@ int growth_count_fixed;
 /** D.D. Following line disabled.   **
   assert (workspace != NULL);
 ***                                **/
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = z->nrows;
+  ncols = z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
 
@@ -895,8 +1266,8 @@ int growth_count_fixed;
   On 8/10/2006 "int *" was changed to "short *".
 */
 /* the following two lines were moved to spr_spread 8/14/2006  **
-  growth_row = (short *)  mem_GetGRCrowptr();
-  growth_col = (short *)  mem_GetGRCcolptr();
+  growth_row = (COORD_TYPE *)  mem_GetGRCrowptr();
+  growth_col = (COORD_TYPE *)  mem_GetGRCcolptr();
 ** D. Donato 8/14/2006                                         */
 
   /*
@@ -1175,6 +1546,602 @@ static void
 
 }
 
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_count_urban_nghbrs
+** PURPOSE:       count the urban neighbors of an interior pixel of z
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   uses the packed urban grid when it is maintained.
+**
+**
+*/
+static int
+  spr_count_urban_nghbrs (grid_view * z,                     /* IN     */
+                          int row,                           /* IN     */
+                          int col)                           /* IN     */
+{
+  if (scen_GetPackedUrbanGridFlag ())
+  {
+    return bgrid_CountZNeighbors (row, col);
+  }
+  return util_count_neighbors (z, row, col, GT, 0);
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_frontier_add
+** PURPOSE:       add an urban pixel to the urban frontier if it qualifies
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   a pixel qualifies when it is an interior urban pixel with
+**                2 to 7 urban neighbors, i.e. when phase 4 could select
+**                it. frontier_flag marks pixels which are or have been in
+**                the frontier; since urban pixels never revert within a
+**                run, a retired pixel (8 urban neighbors) never qualifies
+**                again.
+**
+*/
+static void
+  spr_frontier_add (grid_view * z,                           /* IN     */
+                    int row,                                 /* IN     */
+                    int col)                                 /* IN     */
+{
+  int urb_count;
+
+  if ((row < 1) || (row >= z->nrows - 1) ||
+      (col < 1) || (col >= z->ncols - 1))
+  {
+    return;
+  }
+  if ((GV_PIXEL (z, row, col) == 0) || frontier_flag[GV_OFFSET (z, row, col)])
+  {
+    return;
+  }
+  urb_count = spr_count_urban_nghbrs (z, row, col);
+  if ((urb_count > 1) && (urb_count < 8))
+  {
+    frontier_row[frontier_count] = row;
+    frontier_col[frontier_count] = col;
+    frontier_count++;
+    frontier_flag[GV_OFFSET (z, row, col)] = 1;
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_BuildUrbanFrontier
+** PURPOSE:       build the urban frontier from the seed urban pixels
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   called once per monte carlo run, after z has been seeded
+**                and the zgrwth arrays set. spr_spread then adds newly
+**                urbanized pixels and their neighbors, and spr_phase4
+**                drops pixels which have become surrounded.
+**
+*/
+void
+  spr_BuildUrbanFrontier (GRID_P z)                          /* IN     */
+{
+  COORD_TYPE *seed_row;
+  COORD_TYPE *seed_col;
+  int seed_count;
+  int i;
+  grid_view z_view;
+
+  grid_SetView (&z_view, z);
+  frontier_row = mem_GetUFRrowptr ();
+  frontier_col = mem_GetUFRcolptr ();
+  frontier_flag = mem_GetUFRflagptr ();
+  memset (frontier_flag, 0, mem_GetTotalPixels () * sizeof (PIXEL));
+  frontier_count = 0;
+
+  seed_row = mem_GetGRZrowptr ();
+  seed_col = mem_GetGRZcolptr ();
+  seed_count = mem_GetGRZcount ();
+  for (i = 0; i < seed_count; i++)
+  {
+    spr_frontier_add (&z_view, seed_row[i], seed_col[i]);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_tiled_spread
+** PURPOSE:       spontaneous, new spreading center and organic growth
+**                computed tile by tile
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   replaces spr_phase1n3 and spr_phase4 when TILED_SPREAD is
+**                set. The grid is split into SPREAD_TILE_SIZE square tiles
+**                which are grown independently (on several threads when
+**                built with OpenMP), each from its own random stream keyed
+**                by the tile number and one draw of the main stream.
+**                A tile only writes delta inside itself; growth landing
+**                on a neighboring tile is deferred and applied afterwards
+**                in tile order, so a pixel claimed by its own tile or by
+**                a lower numbered tile wins. The result therefore does
+**                not depend on the number of threads. Phase 5 still runs
+**                serially afterwards.
+**
+*/
+static void
+  spr_tiled_spread (COEFF_TYPE diffusion_coefficient,        /* IN     */
+                    COEFF_TYPE breed_coefficient,            /* IN     */
+                    COEFF_TYPE spread_coefficient,           /* IN     */
+                    grid_view * z,                           /* IN     */
+                    grid_view * delta,                       /* IN/OUT */
+                    grid_view * slp,                         /* IN     */
+                    grid_view * excld,                       /* IN     */
+                    SWGHT_TYPE * swght,                      /* IN     */
+                    int *sng,                                /* IN/OUT */
+                    int *sdc,                                /* IN/OUT */
+                    int *og)                                 /* IN/OUT */
+{
+  char func[] = "spr_tiled_spread";
+  int nrows;
+  int ncols;
+  int tile_rows;
+  int tile_pixels;
+  int tile_halo;
+  int tile_id;
+  int attempts;
+  int base_seed;
+  int i;
+  int row;
+  int col;
+  unsigned int h;
+  spr_tile_info *tile;
+  COORD_TYPE *grow_row;
+  COORD_TYPE *grow_col;
+  int *zidx;
+  COORD_TYPE *defer_row;
+  COORD_TYPE *defer_col;
+  PIXEL *defer_val;
+
+  FUNC_INIT;
+  nrows = z->nrows;
+  ncols = z->ncols;
+  tile_pixels = SPREAD_TILE_SIZE * SPREAD_TILE_SIZE;
+  tile_halo = 4 * SPREAD_TILE_SIZE + 4;
+
+  if (tiles == NULL)
+  {
+    tile_rows = (nrows + SPREAD_TILE_SIZE - 1) / SPREAD_TILE_SIZE;
+    tile_cols = (ncols + SPREAD_TILE_SIZE - 1) / SPREAD_TILE_SIZE;
+    tile_count = tile_rows * tile_cols;
+    tiles = malloc (tile_count * sizeof (spr_tile_info));
+    if (tiles == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory (tiles)",
+               tile_count * sizeof (spr_tile_info));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    for (tile_id = 0; tile_id < tile_count; tile_id++)
+    {
+      tile = &tiles[tile_id];
+      tile->row0 = (tile_id / tile_cols) * SPREAD_TILE_SIZE;
+      tile->col0 = (tile_id % tile_cols) * SPREAD_TILE_SIZE;
+      tile->nrows = MIN (SPREAD_TILE_SIZE, nrows - tile->row0);
+      tile->ncols = MIN (SPREAD_TILE_SIZE, ncols - tile->col0);
+    }
+  }
+  grow_row = mem_GetTSPgrowRowPtr ();
+  grow_col = mem_GetTSPgrowColPtr ();
+  zidx = mem_GetTSPzIdxPtr ();
+  defer_row = mem_GetTSPdeferRowPtr ();
+  defer_col = mem_GetTSPdeferColPtr ();
+  defer_val = mem_GetTSPdeferValPtr ();
+
+  /*
+   *
+   * KEY EACH TILE'S STREAM ON ONE DRAW OF THE MAIN STREAM
+   *
+   */
+  base_seed = RANDOM_INT (2147483646);
+  for (tile_id = 0; tile_id < tile_count; tile_id++)
+  {
+    tile = &tiles[tile_id];
+    h = (unsigned int) base_seed ^ (0x9E3779B9u * (unsigned int) (tile_id + 1));
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    tile->seed = 1 + (RANDOM_SEED_TYPE) (h % 2147483646u);
+    tile->grow_count = 0;
+    tile->defer_count = 0;
+    tile->z_count = 0;
+    tile->sng = 0;
+    tile->sdc = 0;
+    tile->og = 0;
+    tile->successes = 0;
+    tile->z_failure = 0;
+    tile->delta_failure = 0;
+    tile->slope_failure = 0;
+    tile->excluded_failure = 0;
+  }
+
+  /*
+   *
+   * BUCKET THE URBAN PIXELS BY TILE FOR ORGANIC GROWTH
+   *
+   */
+  for (i = 0; i < zgrwth_count; i++)
+  {
+    tile_id = (zgrwth_row[i] / SPREAD_TILE_SIZE) * tile_cols +
+      zgrwth_col[i] / SPREAD_TILE_SIZE;
+    tile = &tiles[tile_id];
+    zidx[tile_id * tile_pixels + tile->z_count] = i;
+    tile->z_count++;
+  }
+
+  attempts = 1 + (int) spr_GetDiffusionValue (diffusion_coefficient);
+
+#pragma omp parallel for schedule(dynamic)
+  for (tile_id = 0; tile_id < tile_count; tile_id++)
+  {
+    spr_tile_grow (&tiles[tile_id],                          /* IN/OUT */
+                   tile_id,                                  /* IN     */
+                   attempts,                                 /* IN     */
+                   breed_coefficient,                        /* IN     */
+                   spread_coefficient,                       /* IN     */
+                   z,                                        /* IN     */
+                   delta,                                    /* IN/OUT */
+                   slp,                                      /* IN     */
+                   excld,                                    /* IN     */
+                   swght);                                   /* IN     */
+  }
+
+  /*
+   *
+   * MERGE THE TILES IN TILE ORDER: FIRST THE GROWTH EACH TILE MADE
+   * INSIDE ITSELF, THEN THE DEFERRED GROWTH ON NEIGHBORING TILES
+   *
+   */
+  for (tile_id = 0; tile_id < tile_count; tile_id++)
+  {
+    tile = &tiles[tile_id];
+    for (i = 0; i < tile->grow_count; i++)
+    {
+      growth_row[growth_count] = grow_row[tile_id * tile_pixels + i];
+      growth_col[growth_count] = grow_col[tile_id * tile_pixels + i];
+      growth_count++;
+    }
+    (*sng) += tile->sng;
+    (*sdc) += tile->sdc;
+    (*og) += tile->og;
+    stats_AddUrbanizationAttempts (tile->successes,
+                                   tile->z_failure,
+                                   tile->delta_failure,
+                                   tile->slope_failure,
+                                   tile->excluded_failure);
+  }
+  for (tile_id = 0; tile_id < tile_count; tile_id++)
+  {
+    tile = &tiles[tile_id];
+    for (i = 0; i < tile->defer_count; i++)
+    {
+      row = defer_row[tile_id * tile_halo + i];
+      col = defer_col[tile_id * tile_halo + i];
+      if (GV_PIXEL (delta, row, col) != 0)
+      {
+        stats_IncrementDeltaFailure ();
+        continue;
+      }
+      GV_PIXEL (delta, row, col) = defer_val[tile_id * tile_halo + i];
+      growth_row[growth_count] = row;
+      growth_col[growth_count] = col;
+      growth_count++;
+      switch (defer_val[tile_id * tile_halo + i])
+      {
+      case PHASE1G:
+        (*sng)++;
+        break;
+      case PHASE3G:
+        (*sdc)++;
+        break;
+      default:
+        (*og)++;
+        break;
+      }
+      stats_IncrementUrbanSuccess ();
+    }
+  }
+  FUNC_END;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_tile_grow
+** PURPOSE:       grow one tile of the tiled spread
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   the tile's share of the spontaneous growth attempts (its
+**                share of the grid, rounded at random) is drawn inside
+**                the tile, followed by new spreading centers and by the
+**                organic growth of the tile's urban pixels, with the rules
+**                of spr_phase1n3 and spr_phase4. Runs concurrently with
+**                other tiles: it only draws from tile->seed and only
+**                writes to its own tile, buffers and record.
+**
+*/
+static void
+  spr_tile_grow (spr_tile_info * tile,                       /* IN/OUT */
+                 int tile_id,                                /* IN     */
+                 int attempts,                               /* IN     */
+                 COEFF_TYPE breed_coefficient,               /* IN     */
+                 COEFF_TYPE spread_coefficient,              /* IN     */
+                 grid_view * z,                              /* IN     */
+                 grid_view * delta,                          /* IN/OUT */
+                 grid_view * slp,                            /* IN     */
+                 grid_view * excld,                          /* IN     */
+                 SWGHT_TYPE * swght)                         /* IN     */
+{
+  PIXEL claims[(SPREAD_TILE_SIZE + 2) * (SPREAD_TILE_SIZE + 2)];
+  int walkabout_row[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+  int walkabout_col[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+  int *zidx;
+  double expected_attempts;
+  int k;
+  int n;
+  int i;
+  int j;
+  int i_nghbr;
+  int j_nghbr;
+  int count;
+  int tries;
+  int direction;
+  int urb_count;
+
+  memset (claims, 0, sizeof (claims));
+  zidx = mem_GetTSPzIdxPtr () + tile_id * SPREAD_TILE_SIZE * SPREAD_TILE_SIZE;
+
+  /*
+   *
+   * SPONTANEOUS GROWTH AND NEW SPREADING CENTERS
+   *
+   */
+  expected_attempts = (double) attempts * tile->nrows * tile->ncols /
+    mem_GetTotalPixels ();
+  n = (int) expected_attempts;
+  if (ran_stream_random (&tile->seed) < expected_attempts - n)
+  {
+    n++;
+  }
+  for (k = 0; k < n; k++)
+  {
+    i = tile->row0 + (int) (ran_stream_random (&tile->seed) * tile->nrows);
+    j = tile->col0 + (int) (ran_stream_random (&tile->seed) * tile->ncols);
+    if (!GV_INTERIOR_PT (z, i, j))
+    {
+      continue;
+    }
+    if (!spr_tile_urbanize (tile, tile_id, i, j, z, delta, slp, excld,
+                            swght, PHASE1G, claims))
+    {
+      continue;
+    }
+    if ((int) (ran_stream_random (&tile->seed) * 101) >= (int) breed_coefficient)
+    {
+      continue;
+    }
+    count = 0;
+    for (tries = 0; tries < 8; tries++)
+    {
+      direction = (int) (ran_stream_random (&tile->seed) * 8);
+      i_nghbr = i + next_nghbr_row[direction];
+      j_nghbr = j + next_nghbr_col[direction];
+      if (spr_tile_urbanize (tile, tile_id, i_nghbr, j_nghbr, z, delta,
+                             slp, excld, swght, PHASE3G, claims))
+      {
+        count++;
+        if (count == MIN_NGHBR_TO_SPREAD)
+        {
+          break;
+        }
+      }
+    }
+  }
+
+  /*
+   *
+   * ORGANIC GROWTH FROM THE TILE'S URBAN PIXELS
+   *
+   */
+  for (k = 0; k < tile->z_count; k++)
+  {
+    i = zgrwth_row[zidx[k]];
+    j = zgrwth_col[zidx[k]];
+    if (!GV_INTERIOR_PT (z, i, j) || (GV_PIXEL (z, i, j) == 0))
+    {
+      continue;
+    }
+    if ((int) (ran_stream_random (&tile->seed) * 101) >= spread_coefficient)
+    {
+      continue;
+    }
+    urb_count = 0;
+    for (n = 0; n < 8; n++)
+    {
+      if (GV_PIXEL (z, i + walkabout_row[n], j + walkabout_col[n]) > 0)
+      {
+        urb_count++;
+      }
+    }
+    if ((urb_count >= 2) && (urb_count < 8))
+    {
+      direction = (int) (ran_stream_random (&tile->seed) * 8);
+      spr_tile_urbanize (tile, tile_id, i + walkabout_row[direction],
+                         j + walkabout_col[direction], z, delta, slp, excld,
+                         swght, PHASE4G, claims);
+    }
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_tile_urbanize
+** PURPOSE:       try to urbanize a pixel from within a tile
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   same tests as spr_urbanize, drawn from the tile's stream.
+**                A pixel inside the tile is written to delta and to the
+**                tile's growth list. A pixel just outside the tile is
+**                claimed in claims (so the tile cannot take it twice) and
+**                queued as a deferred write; its delta test is made when
+**                spr_tiled_spread merges the tiles.
+**
+*/
+static BOOLEAN
+  spr_tile_urbanize (spr_tile_info * tile,                   /* IN/OUT */
+                     int tile_id,                            /* IN     */
+                     int row,                                /* IN     */
+                     int col,                                /* IN     */
+                     grid_view * z,                          /* IN     */
+                     grid_view * delta,                      /* IN/OUT */
+                     grid_view * slp,                        /* IN     */
+                     grid_view * excld,                      /* IN     */
+                     SWGHT_TYPE * swght,                     /* IN     */
+                     PIXEL pixel_value,                      /* IN     */
+                     PIXEL * claims)                         /* IN/OUT */
+{
+  BOOLEAN inside;
+  int claim;
+  int draw;
+  int base;
+
+  if (GV_PIXEL (z, row, col) != 0)
+  {
+    tile->z_failure++;
+    return FALSE;
+  }
+  inside = (row >= tile->row0) && (row < tile->row0 + tile->nrows) &&
+           (col >= tile->col0) && (col < tile->col0 + tile->ncols);
+  claim = (row - tile->row0 + 1) * (SPREAD_TILE_SIZE + 2) +
+          (col - tile->col0 + 1);
+  if ((inside && (GV_PIXEL (delta, row, col) != 0)) ||
+      (!inside && claims[claim]))
+  {
+    tile->delta_failure++;
+    return FALSE;
+  }
+  if (accept_grid != NULL)
+  {
+    draw = (int) (ran_stream_random (&tile->seed) * ACCEPT_SCALE);
+    if (draw >= accept_grid[GV_OFFSET (z, row, col)])
+    {
+      if (draw < ACCEPT_VALUE (1.0 - swght[GV_PIXEL (slp, row, col)]))
+      {
+        tile->excluded_failure++;
+      }
+      else
+      {
+        tile->slope_failure++;
+      }
+      return FALSE;
+    }
+  }
+  else
+  {
+    if (!(ran_stream_random (&tile->seed) > swght[GV_PIXEL (slp, row, col)]))
+    {
+      tile->slope_failure++;
+      return FALSE;
+    }
+    if (!(GV_PIXEL (excld, row, col) <
+          (int) (ran_stream_random (&tile->seed) * 100)))
+    {
+      tile->excluded_failure++;
+      return FALSE;
+    }
+  }
+
+  if (inside)
+  {
+    base = tile_id * SPREAD_TILE_SIZE * SPREAD_TILE_SIZE;
+    GV_PIXEL (delta, row, col) = pixel_value;
+    mem_GetTSPgrowRowPtr ()[base + tile->grow_count] = row;
+    mem_GetTSPgrowColPtr ()[base + tile->grow_count] = col;
+    tile->grow_count++;
+    tile->successes++;
+    switch (pixel_value)
+    {
+    case PHASE1G:
+      tile->sng++;
+      break;
+    case PHASE3G:
+      tile->sdc++;
+      break;
+    default:
+      tile->og++;
+      break;
+    }
+  }
+  else
+  {
+    base = tile_id * (4 * SPREAD_TILE_SIZE + 4);
+    claims[claim] = 1;
+    mem_GetTSPdeferRowPtr ()[base + tile->defer_count] = row;
+    mem_GetTSPdeferColPtr ()[base + tile->defer_count] = col;
+    mem_GetTSPdeferValPtr ()[base + tile->defer_count] = pixel_value;
+    tile->defer_count++;
+  }
+  return TRUE;
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: spr_update_accept_grid
+** PURPOSE:       build the urbanize acceptance grid for the slope weights
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   an urbanization attempt passes the slope test with
+**                probability 1 - swght[slp] and the exclusion test
+**                (excld < RANDOM_INT (100)) with probability
+**                (99 - excld) / 100. Their product is stored per pixel,
+**                scaled by ACCEPT_SCALE, so spr_urbanize needs a single
+**                draw. The slope weights only change with the slope
+**                resistance, so the grid is rebuilt only when they differ
+**                from the ones it was built from.
+**
+*/
+static void
+  spr_update_accept_grid (GRID_P slp,                        /* IN     */
+                          GRID_P excld,                      /* IN     */
+                          SWGHT_TYPE * swght)                /* IN     */
+{
+  int total_pixels;
+  int i;
+  double slope_pass;
+  double excld_pass;
+
+  accept_grid = mem_GetUAGptr ();
+  if (accept_swght_set &&
+      !memcmp (accept_swght, swght, sizeof (accept_swght)))
+  {
+    return;
+  }
+
+  total_pixels = mem_GetTotalPixels ();
+  for (i = 0; i < total_pixels; i++)
+  {
+    slope_pass = 1.0 - swght[slp[i]];
+    excld_pass = (excld[i] < 99) ? (99 - excld[i]) / 100.0 : 0.0;
+    accept_grid[i] = (unsigned short) ACCEPT_VALUE (slope_pass * excld_pass);
+  }
+  memcpy (accept_swght, swght, sizeof (accept_swght));
+  accept_swght_set = TRUE;
+}
+
 /******************************************************************************
 *******************************************************************************
 ** FUNCTION NAME: spr_GetDiffusionValue
@@ -1264,21 +2231,23 @@ static COEFF_TYPE
 static BOOLEAN
   spr_urbanize (int row,                                     /* IN     */
                 int col,                                     /* IN     */
-                GRID_P z,                                    /* IN     */
-                GRID_P delta,                                /* IN/OUT */
-                GRID_P slp,                                  /* IN     */
-                GRID_P excld,                                /* IN     */
+                grid_view * z,                               /* IN     */
+                grid_view * delta,                           /* IN/OUT */
+                grid_view * slp,                             /* IN     */
+                grid_view * excld,                           /* IN     */
                 SWGHT_TYPE * swght,                          /* IN     */
                 PIXEL pixel_value,                           /* IN     */
                 int *stat)                                   /* IN/OUT */
 {
   char func[] = "spr_urbanize";
   BOOLEAN val;
+  int draw;
+  int offset;
   int nrows;
   int ncols;
 
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = z->nrows;
+  ncols = z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
 
@@ -1291,28 +2260,44 @@ static BOOLEAN
   assert (excld != NULL);
   assert (swght != NULL);
   assert (stat != NULL);
+  assert ((delta->stride == z->stride) && (slp->stride == z->stride) &&
+          (excld->stride == z->stride));
 
+  offset = GV_OFFSET (z, row, col);
 
   val = FALSE;
-  if (z[OFFSET ((row), (col))] == 0)
+  if (z->ptr[offset] == 0)
   {
-    if (delta[OFFSET ((row), (col))] == 0)
+    if (delta->ptr[offset] == 0)
     {
-      if (RANDOM_FLOAT > swght[slp[OFFSET ((row), (col))]])
+      if (accept_grid != NULL)
       {
-        if (excld[OFFSET ((row), (col))] < RANDOM_INT (100))
+        /*
+         *
+         * ONE DRAW AGAINST THE COMBINED ACCEPTANCE. A DRAW WHICH
+         * FAILS BUT STILL FALLS UNDER THE SLOPE PASS RATE IS
+         * CHARGED TO THE EXCLUSION TEST.
+         *
+         */
+        draw = RANDOM_INT (ACCEPT_SCALE);
+        if (draw < accept_grid[offset])
+        {
+          val = TRUE;
+        }
+        else if (draw < ACCEPT_VALUE (1.0 - swght[slp->ptr[offset]]))
+        {
+          stats_IncrementEcludedFailure ();
+        }
+        else
+        {
+          stats_IncrementSlopeFailure ();
+        }
+      }
+      else if (RANDOM_FLOAT > swght[slp->ptr[offset]])
+      {
+        if (excld->ptr[offset] < RANDOM_INT (100))
         {
           val = TRUE;
-          delta[OFFSET (row, col)] = pixel_value;
-            if (pixel_value != 0) /** D. Donato 8/14/2006 - If statement added **/
-              {
-               growth_row[growth_count] = row;
-               growth_col[growth_count] = col;
-               growth_count++;
-              }
-
-          (*stat)++;
-          stats_IncrementUrbanSuccess ();
         }
         else
         {
@@ -1323,6 +2308,19 @@ static BOOLEAN
       {
         stats_IncrementSlopeFailure ();
       }
+      if (val)
+      {
+        delta->ptr[offset] = pixel_value;
+          if (pixel_value != 0) /** D. Donato 8/14/2006 - If statement added **/
+            {
+             growth_row[growth_count] = row;
+             growth_col[growth_count] = col;
+             growth_count++;
+            }
+
+        (*stat)++;
+        stats_IncrementUrbanSuccess ();
+      }
     }
     else
     {
@@ -1353,7 +2351,8 @@ static BOOLEAN
 */
 static
   void
-  spr_get_neighbor (int i_in,                                /* IN     */
+  spr_get_neighbor (grid_view * grid,                        /* IN     */
+                    int i_in,                                /* IN     */
                     int j_in,                                /* IN     */
                     int *i_out,                              /* OUT    */
                     int *j_out)                              /* OUT    */
@@ -1362,17 +2361,13 @@ static
   int i;
   int j;
   int k;
-  int nrows;
-  int ncols;
 
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
-  assert (nrows > 0);
-  assert (ncols > 0);
+  assert (grid->nrows > 0);
+  assert (grid->ncols > 0);
 
   FUNC_INIT;
-  assert (nrows > i_in);
-  assert (ncols > j_in);
+  assert (grid->nrows > i_in);
+  assert (grid->ncols > j_in);
   assert (0 <= i_in);
   assert (0 <= j_in);
   assert (i_out != NULL);
@@ -1383,7 +2378,7 @@ static
   {
     i = (*i_out);
     j = (*j_out);
-    if (IMAGE_PT (i, j))
+    if (GV_IMAGE_PT (grid, i, j))
     {
       break;
     }
@@ -1409,10 +2404,10 @@ static
                       int j,                                 /* IN     */
                       int *i_nghbr,                          /* OUT    */
                       int *j_nghbr,                          /* OUT    */
-                      GRID_P z,                              /* IN     */
-                      GRID_P delta,                          /* IN/OUT */
-                      GRID_P slp,                            /* IN     */
-                      GRID_P excld,                          /* IN     */
+                      grid_view * z,                         /* IN     */
+                      grid_view * delta,                     /* IN/OUT */
+                      grid_view * slp,                       /* IN     */
+                      grid_view * excld,                     /* IN     */
                       SWGHT_TYPE * swght,                    /* IN     */
                       PIXEL pixel_value,                     /* IN     */
                       int *stat)                             /* IN/OUT */
@@ -1430,9 +2425,10 @@ static
   assert (swght != NULL);
   assert (stat != NULL);
 
-  if (IMAGE_PT (i, j))
+  if (GV_IMAGE_PT (z, i, j))
   {
-    spr_get_neighbor (i,                                     /* IN    */
+    spr_get_neighbor (z,                                     /* IN    */
+                      i,                                     /* IN    */
                       j,                                     /* IN    */
                       i_nghbr,                               /* OUT   */
                       j_nghbr);                              /* OUT   */
@@ -1475,9 +2471,8 @@ static
   char func[] = "spr_road_walk";
   int i;
   int j;
-  int i_nghbr;
-  int j_nghbr;
   int k;
+  PIXEL mask;
   BOOLEAN end_of_road;
   BOOLEAN spread = FALSE;
   int run_value;
@@ -1493,22 +2488,24 @@ static
   end_of_road = FALSE;
   while (!end_of_road)
   {
-    end_of_road = TRUE;
-    util_get_next_neighbor (i, j, &i_nghbr, &j_nghbr, RANDOM_INT (8));
-    for (k = 0; k < 8; k++)
+    /*
+     *
+     * STEP TO THE FIRST ROAD NEIGHBOR FOUND TURNING FROM A
+     * RANDOM DIRECTION (SEE spr_BuildRoadNghbrMask)
+     *
+     */
+    k = RANDOM_INT (8);
+    mask = road_nghbr_mask[OFFSET (i, j)];
+    end_of_road = (mask == 0);
+    if (!end_of_road)
     {
-      if (IMAGE_PT (i_nghbr, j_nghbr))
+      while (!(mask & (1 << k)))
       {
-        if (roads[OFFSET (i_nghbr, j_nghbr)])
-        {
-          end_of_road = FALSE;
-          run++;
-          i = i_nghbr;
-          j = j_nghbr;
-          break;
-        }
+        k = (k + 1) % 8;
       }
-      util_get_next_neighbor (i, j, &i_nghbr, &j_nghbr, -1);
+      run++;
+      i += next_nghbr_row[k];
+      j += next_nghbr_col[k];
     }
     run_value = (int) (roads[OFFSET (i, j)] / MAX_ROAD_VALUE *
                        diffusion_coefficient);
@@ -1537,8 +2534,8 @@ static
 */
 static
     BOOLEAN
-  spr_road_search (short i_grwth_center,                     /* IN     */
-                   short j_grwth_center,                     /* IN     */
+  spr_road_search (int i_grwth_center,                       /* IN     */
+                   int j_grwth_center,                       /* IN     */
                    int *i_road,                              /* OUT    */
                    int *j_road,                              /* OUT    */
                    int max_search_index,                     /* IN     */
@@ -1666,22 +2663,8 @@ static
 	  road_found = TRUE;
 	  //check if there is any closer road pixel in this iteration's expanded road pixels
 	  int minDistance = spr_max_norm(foundRow, foundCol, i_grwth_center, j_grwth_center);
-	  for (int road_index = 0; road_index < road_expansion_count; road_index++) {
-		  int roadRow = road_expansion_row[road_index];
-		  int roadCol = road_expansion_col[road_index];
-		  int distanceToNewRoad = spr_max_norm(roadRow, roadCol, i_grwth_center, j_grwth_center);
-		  if (minDistance > distanceToNewRoad && distanceToNewRoad != 0) {
-
-			  /*fprintf(stdout, "\nCloser new road pixel to (%i, %i) found, d(%i, %i)=%f instead of d(%i, %i)=%f \n", 
-				  i_grwth_center, j_grwth_center,
-				  roadRow, roadCol, distanceToNewRoad,
-				  foundRow, foundCol, minDistance);*/
-			  
-			  foundRow = roadRow;
-			  foundCol = roadCol;
-			  minDistance = distanceToNewRoad;
-		  }
-	  }
+	  spr_closest_road_expansion(i_grwth_center, j_grwth_center, FALSE,
+		  0, 0, &minDistance, &foundRow, &foundCol);
   } 
 
   (*i_road) = foundRow;  (*j_road) = foundCol;
@@ -1776,10 +2759,10 @@ void
 
 /* D.D. 8/18/2006 */
   int   row,col, colindex;
-  short *ExcPixRow;
-  short *ExcPixCol;
-  short *UrbPixRow;
-  short *UrbPixCol;
+  COORD_TYPE *ExcPixRow;
+  COORD_TYPE *ExcPixCol;
+  COORD_TYPE *UrbPixRow;
+  COORD_TYPE *UrbPixCol;
 /* D.D. 8/18/2006 */
 
   double road_gravity;
@@ -1788,24 +2771,39 @@ void
   COEFF_TYPE spread_coefficient;
   GRID_P excld;
   GRID_P slp;
+  grid_view z_view;
+  grid_view delta_view;
+  grid_view slp_view;
+  grid_view excld_view;
+  int offset;
 /*GRID_P scratch_gif1;  */
   /* D.D. Commented out July 24, 2006 - Now using int growth row and column
           arrays instead of a wgrid.
   GRID_P scratch_gif3;
   */
   SWGHT_TYPE swght[SLOPE_WEIGHT_ARRAY_SZ];
+  BOOLEAN packed_urban_grid;
+  int first_new_pixel;
+  int k;
+  int walkabout_row[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+  int walkabout_col[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
 
 /** The following three lines were moved from spr_phase5                       **/
-  growth_row = (short *)  mem_GetGRCrowptr();
-  growth_col = (short *)  mem_GetGRCcolptr();
+  growth_row = (COORD_TYPE *)  mem_GetGRCrowptr();
+  growth_col = (COORD_TYPE *)  mem_GetGRCcolptr();
 /*******************          D.D. Aug. 14, 2006      (End)  ******************/
   road_expansion_row = mem_GetRERCrowptr();
   road_expansion_col = mem_GetRERCcolptr();
+  road_expansion_head = mem_GetRERHheadptr();
+  road_expansion_next = mem_GetRERHnextptr();
+  road_expansion_bucket_rows = mem_GetRERHbucketRows();
+  road_expansion_bucket_cols = mem_GetRERHbucketCols();
 
   road_gravity = coeff_GetCurrentRoadGravity ();
   diffusion_coefficient = coeff_GetCurrentDiffusion ();
   breed_coefficient = coeff_GetCurrentBreed ();
   spread_coefficient = coeff_GetCurrentSpread ();
+  packed_urban_grid = scen_GetPackedUrbanGridFlag ();
 
 /** D.D. 8/29/2006                                                         ***
   scratch_gif1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
@@ -1842,6 +2840,11 @@ void
   assert (nrows > 0);
   assert (ncols > 0);
 
+  grid_SetView (&z_view, z);
+  grid_SetView (&delta_view, delta);
+  grid_SetView (&slp_view, slp);
+  grid_SetView (&excld_view, excld);
+
 
   /*
    *
@@ -1861,12 +2864,14 @@ void
 
       for (i=0; i<growth_count; i++)
           {
-           delta[OFFSET(growth_row[i], growth_col[i])] = 0;
+           delta[GV_OFFSET (&z_view, growth_row[i], growth_col[i])] = 0;
           }
 
   growth_count = 0;
 
   road_expansion_count = 0;
+  memset (road_expansion_head, -1,
+          road_expansion_bucket_rows * road_expansion_bucket_cols * sizeof (int));
 
   /*
    *
@@ -1875,6 +2880,13 @@ void
    */
   spr_get_slp_weights (SLOPE_WEIGHT_ARRAY_SZ,                /* IN     */
                        swght);                               /* OUT    */
+  accept_grid = NULL;
+  if (scen_GetUrbanizeAcceptanceGridFlag ())
+  {
+    spr_update_accept_grid (slp,                             /* IN     */
+                            excld,                           /* IN     */
+                            swght);                          /* IN     */
+  }
 
 /***                          D.D. July 28, 2006               (Begin)       **/
 /***  Call the routine to initialize the array of pointer to road grids.    **/
@@ -1895,8 +2907,8 @@ void
 /*******************          D.D. Aug. 14, 2006      (End)  ******************/
 
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
-  zgrwth_row = (short *)  mem_GetGRZrowptr();
-  zgrwth_col = (short *)  mem_GetGRZcolptr();
+  zgrwth_row = (COORD_TYPE *)  mem_GetGRZrowptr();
+  zgrwth_col = (COORD_TYPE *)  mem_GetGRZcolptr();
   zgrwth_count =          mem_GetGRZcount();
 /** D. Donato 8/17/2006 Added to deal with cumulative growth                 **/
 
@@ -1906,33 +2918,57 @@ void
    *
    */
 
-  timer_Start (SPR_PHASE1N3);
-  spr_phase1n3 (diffusion_coefficient,                       /* IN     */
-                breed_coefficient,                           /* IN     */
-                z,                                           /* IN     */
-                delta,                                       /* IN/OUT */
-                slp,                                         /* IN     */
-                excld,                                       /* IN     */
+  if (scen_GetTiledSpreadFlag ())
+  {
+    /*
+     *
+     * PHASES 1N3 AND 4 COMPUTED TILE BY TILE (TIMED AS PHASE 1N3)
+     *
+     */
+    timer_Start (SPR_PHASE1N3);
+    spr_tiled_spread (diffusion_coefficient,                 /* IN     */
+                      breed_coefficient,                     /* IN     */
+                      spread_coefficient,                    /* IN     */
+                      &z_view,                               /* IN     */
+                      &delta_view,                           /* IN/OUT */
+                      &slp_view,                             /* IN     */
+                      &excld_view,                           /* IN     */
+                      swght,                                 /* IN     */
+                      sng,                                   /* IN/OUT */
+                      sdc,                                   /* IN/OUT */
+                      og);                                   /* IN/OUT */
+    timer_Stop (SPR_PHASE1N3);
+  }
+  else
+  {
+    timer_Start (SPR_PHASE1N3);
+    spr_phase1n3 (diffusion_coefficient,                     /* IN     */
+                  breed_coefficient,                         /* IN     */
+                  &z_view,                                   /* IN     */
+                  &delta_view,                               /* IN/OUT */
+                  &slp_view,                                 /* IN     */
+                  &excld_view,                               /* IN     */
+                  swght,                                     /* IN     */
+                  sng,                                       /* IN/OUT */
+                  sdc);                                      /* IN/OUT */
+    timer_Stop (SPR_PHASE1N3); 
+
+    /*
+     *
+     * PHASE 4 - ORGANIC GROWTH
+     *
+     */
+
+    timer_Start (SPR_PHASE4);
+    spr_phase4 (spread_coefficient,                          /* IN     */
+                &z_view,                                     /* IN     */
+                &excld_view,                                 /* IN     */
+                &delta_view,                                 /* IN/OUT */
+                &slp_view,                                   /* IN     */
                 swght,                                       /* IN     */
-                sng,                                         /* IN/OUT */
-                sdc);                                        /* IN/OUT */
-  timer_Stop (SPR_PHASE1N3); 
-
-  /*
-   *
-   * PHASE 4 - ORGANIC GROWTH
-   *
-   */
-
-  timer_Start (SPR_PHASE4);
-  spr_phase4 (spread_coefficient,                            /* IN     */
-              z,                                             /* IN     */
-              excld,                                         /* IN     */
-              delta,                                         /* IN/OUT */
-              slp,                                           /* IN     */
-              swght,                                         /* IN     */
-              og);                                           /* IN/OUT */
-  timer_Stop (SPR_PHASE4);
+                og);                                         /* IN/OUT */
+    timer_Stop (SPR_PHASE4);
+  }
 
   /*
    *
@@ -1944,10 +2980,10 @@ void
   spr_phase5 (road_gravity,                                  /* IN     */
               diffusion_coefficient,                         /* IN     */
               breed_coefficient,                             /* IN     */
-              z,                                             /* IN     */
-              delta,                                         /* IN/OUT */
-              slp,                                           /* IN     */
-              excld,                                         /* IN     */
+              &z_view,                                       /* IN     */
+              &delta_view,                                   /* IN/OUT */
+              &slp_view,                                     /* IN     */
+              &excld_view,                                   /* IN     */
 			  road_state_ptr,                                /* IN/OUT */
               swght,                                         /* IN     */
               rt);                                           /* IN/OUT */
@@ -1968,8 +3004,8 @@ void
 
       for (i=0; i<growth_count; i++)
           {
-           if (delta[OFFSET(growth_row[i], growth_col[i])] > PHASE5G)
-              {delta[OFFSET(growth_row[i], growth_col[i])] = 0;}
+           if (delta[GV_OFFSET (&z_view, growth_row[i], growth_col[i])] > PHASE5G)
+              {delta[GV_OFFSET (&z_view, growth_row[i], growth_col[i])] = 0;}
           }
 
 /** D.D. 8/18/2006                                                            **/
@@ -1993,8 +3029,8 @@ void
          {
           for (col=0; col<ExcPixRow[row]; col++)
               {
-               if (excld[OFFSET(row, ExcPixCol[colindex])] >= 100)
-                   delta[OFFSET(row, ExcPixCol[colindex])] = 0;
+               if (excld[GV_OFFSET (&z_view, row, ExcPixCol[colindex])] >= 100)
+                   delta[GV_OFFSET (&z_view, row, ExcPixCol[colindex])] = 0;
                colindex++;
               }
          }
@@ -2023,15 +3059,21 @@ void
 ***  D. Donato Aug. 14, 2006                                            */
 
 /**  D. Donato Aug. 14, 2006             New loop   Corrected 8/17/2006 */
+  first_new_pixel = zgrwth_count;
   for (i=0; i<growth_count; i++)
   {
-    if (    (z[OFFSET(growth_row[i], growth_col[i])] == 0) &&
-        (delta[OFFSET(growth_row[i], growth_col[i])]  > 0)   )
+    offset = GV_OFFSET (&z_view, growth_row[i], growth_col[i]);
+    if (    (z[offset] == 0) &&
+        (delta[offset]  > 0)   )
      {
       /* new growth being placed into array */
-      (*average_slope) += (float) slp[OFFSET(growth_row[i], growth_col[i])];
-          z[OFFSET(growth_row[i], growth_col[i])] =
-      delta[OFFSET(growth_row[i], growth_col[i])];
+      (*average_slope) += (float) slp[offset];
+          z[offset] =
+      delta[offset];
+      if (packed_urban_grid)
+      {
+        bgrid_SetZ (growth_row[i], growth_col[i]);
+      }
          zgrwth_row[zgrwth_count] = growth_row[i];
          zgrwth_col[zgrwth_count] = growth_col[i];
          zgrwth_count++;
@@ -2040,6 +3082,25 @@ void
   }
 /** D. Donato Aug. 14, 2006          End of New Loop                    */
 
+  /*
+   *
+   * NEW URBAN PIXELS MAY JOIN THE URBAN FRONTIER, AS MAY THEIR
+   * NEIGHBORS (WHICH NOW HAVE ONE MORE URBAN NEIGHBOR)
+   *
+   */
+  if (scen_GetUrbanFrontierFlag ())
+  {
+    for (i = first_new_pixel; i < zgrwth_count; i++)
+    {
+      spr_frontier_add (&z_view, zgrwth_row[i], zgrwth_col[i]);
+      for (k = 0; k < 8; k++)
+      {
+        spr_frontier_add (&z_view, zgrwth_row[i] + walkabout_row[k],
+                          zgrwth_col[i] + walkabout_col[k]);
+      }
+    }
+  }
+
 /** D.D. 8/18/2006 Use the zgrwth  arrays to count pixels in z more efficiently. ***
   *pop = util_count_pixels (total_pixels, z, GE, PHASE0G);
 ***                                                                              **/
@@ -2047,7 +3108,7 @@ void
   *pop = 0;
   for (i=0; i<zgrwth_count; i++)
   {
-   if (z[OFFSET(zgrwth_row[i], zgrwth_col[i])] >= PHASE0G) {*pop++;}
+   if (z[GV_OFFSET (&z_view, zgrwth_row[i], zgrwth_col[i])] >= PHASE0G) {*pop++;}
   }
 
 /** D.D. 8/18/2006 Use the zgrwth  arrays to count pixels in z more efficiently. **/
@@ -45,4 +45,10 @@ void
               GRID_P z,                                     /* IN/OUT */
 			  GRID_P road_state_ptr);
 
+void
+  spr_BuildUrbanFrontier (GRID_P z);                         /* IN     */
+
+void
+  spr_BuildRoadNghbrMask (GRID_P roads);                     /* IN     */
+
 #endif
@@ -41,6 +41,9 @@
 #include "stats_obj.h"
 #include "coeff_obj.h"
 #include "utilities.h"
+#include "bgrid_obj.h"
+#include "egrid_obj.h"
+#include "rstore_obj.h"
 
   /*VerD*/
   extern FILE *fpVerD2;
@@ -123,19 +126,53 @@ static char *stats_val_t_names[] = {
   "leesalee",
   "grw_pix"
 };
+static char *control_stats_names[] = {
+  "Run", "Product", "Compare", "Pop", "Edges", "Clusters", "Size",
+  "Leesalee", "Slope", "%Urban", "Xmean", "Ymean", "Rad", "Fmatch",
+  "OSM", "Diff", "Brd", "Sprd", "Slp", "RG"
+};
 static stats_info stats_actual[MAX_URBAN_YEARS];
 static stats_info regression;
 static stats_val_t average[MAX_URBAN_YEARS];
 static stats_val_t std_dev[MAX_URBAN_YEARS];
 static stats_val_t running_total[MAX_URBAN_YEARS];
-static struct
+typedef struct
 {
   int run;
   int monte_carlo;
   int year;
   stats_val_t this_year;
 }
-record;
+stats_record;
+static stats_record record;
+
+/* Welford moments of the saved records of each year, indexed like
+   running_total when calibrating and by year - prediction start date
+   when predicting */
+typedef struct
+{
+  int count;
+  stats_val_t sum;
+  stats_val_t mean;
+  stats_val_t m2;
+}
+stats_moments;
+static stats_moments *moments;
+static int num_moments;
+
+/* statistics plan of stats_Update: the full record is only computed for
+   the years whose record is read, the other years only get the
+   population and the growth rate needed by the self-modification */
+static struct
+{
+  BOOLEAN save_every_year;      /* predicting, and a log asks for it */
+}
+plan;
+#define STATS_VAL_COUNT (sizeof (stats_val_t) / sizeof (double))
+
+/* control year records waiting for their ensemble (egrid) counts */
+static stats_record ensemble_record[MAX_URBAN_YEARS][EGRID_REPLICATES];
+static int ensemble_record_count[MAX_URBAN_YEARS];
 
 static struct
 {
@@ -172,11 +209,25 @@ ugm_link;
 static struct ugm_link cir_q[SIZE_CIR_Q];
 
 /** D. Donato 8/21/2006 Added to deal with cumulative growth                 **/
-  short *zgrwth_row;
-  short *zgrwth_col;
+  COORD_TYPE *zgrwth_row;
+  COORD_TYPE *zgrwth_col;
   int    zgrwth_count;
 /** D. Donato 8/21/2006 Added to deal with cumulative growth                 **/
 
+/* Lee-Sallee counts of this year, gathered by stats_sweep */
+static BOOLEAN leesalee_counted;
+static int leesalee_intersection;
+static int leesalee_union;
+
+/* union-find of the clusters of interior urban pixels of Z, fed from the
+   cumulative growth list: cluster_parent[i] is 0 for pixels outside the
+   clusters, -(size) for a root and the offset of the parent otherwise
+   (offset 0 is a corner, never interior, so it is never a parent) */
+static int *cluster_parent;
+static int cluster_added;
+static int cluster_count;
+static int cluster_pixels;
+
 /*****************************************************************************\
 *******************************************************************************
 **                                                                           **
@@ -185,12 +236,14 @@ static struct ugm_link cir_q[SIZE_CIR_Q];
 *******************************************************************************
 \*****************************************************************************/
 static void stats_Save (char *filename);
+static void stats_SaveRecord (char *filename);
+static void stats_DeferRecord ();
 static void stats_LogThisYearStats (FILE * fp);
 static void stats_CalGrowthRate ();
 static void stats_CalPercentUrban (int, int, int);
 static void stats_CalAverages (int index);
 static void stats_WriteControlStats (char *filename);
-static void stats_WriteStatsValLine (char *filename, int run,
+static void stats_WriteStatsValLine (char *filename, char *table, int run,
                            int year, stats_val_t * stats_ptr, int index);
 static void stats_LogStatInfoHdr (FILE * fp);
 static void stats_LogStatInfo (int run, int year, int index,
@@ -198,10 +251,14 @@ static void stats_LogStatInfo (int run, int year, int index,
 static void stats_LogStatVal (int run, int year, int index,
                               stats_val_t * stats_ptr, FILE * fp);
 static void stats_LogStatValHdr (FILE * fp);
-static void stats_ComputeThisYearStats ();
+static void stats_ComputeThisYearStats (BOOLEAN full);
+static void stats_SetPlan ();
+static int stats_count_urban (GRID_P Z);
 static void stats_SetNumGrowthPixels (int val);
 static void stats_CalLeesalee ();
-static void stats_ProcessGrowLog (int run, int year);
+static void stats_ClearMoments ();
+static void stats_UpdateMoments (int index);
+static void stats_WriteGrowLog (char *filename);
 static void stats_DoAggregate (double fmatch);
 static void stats_DoRegressions ();
 static double stats_linefit (double *dependent,
@@ -224,27 +281,46 @@ static void
                          GRID_P scratch_gif1,                /* MOD    */
                          GRID_P scratch_gif2);             /* MOD    */
 static void
-    stats_edge (GRID_P Z,                                    /* IN     */
+    stats_edge (grid_view * Z,                               /* IN     */
                 double *stats_area,                          /* OUT    */
                 double *stats_edges);                      /* OUT    */
 static void
-    stats_circle (GRID_P Z,                                  /* IN     */
-                  GRID_P slp,                                /* IN     */
+    stats_circle (grid_view * Z,                             /* IN     */
+                  grid_view * slp,                           /* IN     */
                   int stats_area,                            /* IN     */
                   double *stats_xmean,                       /* OUT    */
                   double *stats_ymean,                       /* OUT    */
                   double *stats_average_slope,               /* OUT    */
                   double *stats_rad);                      /* OUT    */
 static void
-    stats_cluster (GRID_P Z,                                 /* IN     */
+    stats_cluster (grid_view * Z,                            /* IN     */
                    double *stats_clusters,                   /* OUT    */
                    double *stats_pop,                        /* OUT    */
                    double *stats_mean_cluster_size,          /* OUT    */
                    GRID_P scratch_gif1,                      /* MOD    */
                    GRID_P scratch_gif2);                   /* MOD    */
+static void
+    stats_sweep (grid_view * Z,                              /* IN     */
+                 grid_view * slp,                            /* IN     */
+                 GRID_P urban,                               /* IN     */
+                 BOOLEAN count_edges,                        /* IN     */
+                 double *stats_area,                         /* OUT    */
+                 double *stats_edges,                        /* OUT    */
+                 double *stats_clusters,                     /* OUT    */
+                 double *stats_pop,                          /* OUT    */
+                 double *stats_xmean,                        /* OUT    */
+                 double *stats_ymean,                        /* OUT    */
+                 double *stats_average_slope,                /* OUT    */
+                 double *stats_rad,                          /* OUT    */
+                 double *stats_mean_cluster_size,            /* OUT    */
+                 int *intersection);                       /* OUT    */
+static void stats_add_clusters (grid_view * Z);
+static int stats_cluster_root (int *parent, int offset);
+static BOOLEAN stats_cluster_union (int *parent, int a, int b);
+static void stats_base_sweep (GRID_P urban, GRID_P slp, stats_info * actual);
 static void stats_ClearStatsValArrays ();
 static void stats_ComputeBaseStats ();
-static void stats_CalStdDev (int index);
+static void stats_CalStdDev (int index, stats_moments * moment);
 static void
     stats_compute_leesalee (GRID_P Z,                        /* IN     */
                             GRID_P urban,                    /* IN     */
@@ -552,14 +628,18 @@ void
   road_pixel_count = igrid_GetIGridRoadPixelCount (proc_GetCurrentYear ());
   excluded_pixel_count = igrid_GetIGridExcludedPixelCount ();
 
-  stats_ComputeThisYearStats ();
+  stats_ComputeThisYearStats (plan.save_every_year ||
+                              igrid_TestForUrbanYear (proc_GetCurrentYear ()));
   stats_SetNumGrowthPixels (num_growth_pix);
   stats_CalGrowthRate ();
   stats_CalPercentUrban (total_pixels, road_pixel_count, excluded_pixel_count);
 
   if (igrid_TestForUrbanYear (proc_GetCurrentYear ()))
   {
-    stats_CalLeesalee ();
+    if (!egrid_IsDeferredYear (proc_GetCurrentYear ()))
+    {
+      stats_CalLeesalee ();
+    }
     sprintf (filename, "%sgrow_%u_%u.log",
     scen_GetOutputDir (), proc_GetCurrentRun (), proc_GetCurrentYear ());
 
@@ -588,7 +668,7 @@ void
 
     stats_Save (filename);
   }
-  if (proc_GetProcessingType () == PREDICTING)
+  if ((proc_GetProcessingType () == PREDICTING) && plan.save_every_year)
   {
     sprintf (filename, "%sgrow_%u_%u.log", scen_GetOutputDir (),
              proc_GetCurrentRun (), proc_GetCurrentYear ());
@@ -612,6 +692,8 @@ void
   static BOOLEAN first_call = TRUE;
 
   stats_ClearStatsValArrays ();
+  stats_ClearMoments ();
+  stats_SetPlan ();
   if (first_call)
   {
     stats_ComputeBaseStats ();
@@ -625,52 +707,26 @@ void
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   the standard deviation over the Monte Carlo iterations,
+**                from the moments of the year
 **
 */
 static void
-  stats_CalStdDev (int index)
+  stats_CalStdDev (int index, stats_moments * moment)
 {
-#define SD(val) pow(((val)*(val)/total_monte_carlo),0.5)
+  double *m2;
+  double *sd;
   int total_monte_carlo;
+  int k;
 
   total_monte_carlo = scen_GetMonteCarloIterations ();
 
-  std_dev[index].sng = SD (record.this_year.sng - average[index].sng);
-  std_dev[index].sdg = SD (record.this_year.sdg - average[index].sdg);
-  std_dev[index].sdc = SD (record.this_year.sdc - average[index].sdc);
-  std_dev[index].og = SD (record.this_year.og - average[index].og);
-  std_dev[index].rt = SD (record.this_year.rt - average[index].rt);
-  std_dev[index].pop = SD (record.this_year.pop - average[index].pop);
-  std_dev[index].area = SD (record.this_year.area - average[index].area);
-  std_dev[index].edges = SD (record.this_year.edges - average[index].edges);
-  std_dev[index].clusters =
-    SD (record.this_year.clusters - average[index].clusters);
-  std_dev[index].xmean = SD (record.this_year.xmean - average[index].xmean);
-  std_dev[index].ymean = SD (record.this_year.ymean - average[index].ymean);
-  std_dev[index].rad = SD (record.this_year.rad - average[index].rad);
-  std_dev[index].slope = SD (record.this_year.slope - average[index].slope);
-  std_dev[index].mean_cluster_size =
-    SD (record.this_year.mean_cluster_size - average[index].mean_cluster_size);
-  std_dev[index].diffusion =
-    SD (record.this_year.diffusion - average[index].diffusion);
-  std_dev[index].spread = SD (record.this_year.spread - average[index].spread);
-  std_dev[index].breed = SD (record.this_year.breed - average[index].breed);
-  std_dev[index].slope_resistance =
-    SD (record.this_year.slope_resistance - average[index].slope_resistance);
-  std_dev[index].road_gravity =
-    SD (record.this_year.road_gravity - average[index].road_gravity);
-  std_dev[index].percent_urban =
-    SD (record.this_year.percent_urban - average[index].percent_urban);
-  std_dev[index].percent_road =
-    SD (record.this_year.percent_road - average[index].percent_road);
-  std_dev[index].growth_rate =
-    SD (record.this_year.growth_rate - average[index].growth_rate);
-  std_dev[index].leesalee =
-    SD (record.this_year.leesalee - average[index].leesalee);
-  std_dev[index].num_growth_pix =
-    SD (record.this_year.num_growth_pix - average[index].num_growth_pix);
+  m2 = (double *) &moment->m2;
+  sd = (double *) &std_dev[index];
+  for (k = 0; k < STATS_VAL_COUNT; k++)
+  {
+    sd[k] = pow (m2[k] / total_monte_carlo, 0.5);
+  }
 }
 /******************************************************************************
 *******************************************************************************
@@ -826,6 +882,8 @@ static void
   char func[] = "stats_CalLeesalee";
   GRID_P z_ptr;
   GRID_P urban_ptr;
+  int intersection;
+  int the_union;
 
   z_ptr = pgrid_GetZPtr ();
   urban_ptr = igrid_GetUrbanGridPtrByYear (__FILE__, func,
@@ -833,9 +891,25 @@ static void
   record.this_year.leesalee = 1.0;
   if (proc_GetProcessingType () != PREDICTING)
   {
-    stats_compute_leesalee (z_ptr,                           /* IN     */
-                            urban_ptr,                       /* IN     */
-                            &record.this_year.leesalee);   /* OUT    */
+    if (leesalee_counted)
+    {
+      record.this_year.leesalee = (double) leesalee_intersection /
+        leesalee_union;
+    }
+    else if (scen_GetPackedUrbanGridFlag ())
+    {
+      bgrid_CountIntersectionUnion (bgrid_GetZBitsPtr (),
+           bgrid_GetUrbanBitsPtr (igrid_UrbanYear2Index (proc_GetCurrentYear ())),
+                                    &intersection,
+                                    &the_union);
+      record.this_year.leesalee = (double) intersection / the_union;
+    }
+    else
+    {
+      stats_compute_leesalee (z_ptr,                         /* IN     */
+                              urban_ptr,                     /* IN     */
+                              &record.this_year.leesalee); /* OUT    */
+    }
   }
   urban_ptr = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr);
 
@@ -1417,13 +1491,13 @@ double
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   When full is FALSE only the area and the population are
+**                computed; the other statistics of the record are stale.
 **
 */
 
 static void
-  stats_ComputeThisYearStats ()
+  stats_ComputeThisYearStats (BOOLEAN full)
 {
   char func[] = "stats_ComputeThisYearStats";
   int total_pixels;
@@ -1445,6 +1519,14 @@ static void
   assert (total_pixels > 0);
   z_ptr = pgrid_GetZPtr ();
   assert (z_ptr != NULL);
+  leesalee_counted = FALSE;
+
+  if (!full)
+  {
+    record.this_year.area = stats_count_urban (z_ptr);
+    record.this_year.pop = record.this_year.area;
+    return;
+  }
 
   slope_ptr = igrid_GetSlopeGridPtr (__FILE__, func, __LINE__);
   stats_workspace1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
@@ -1485,6 +1567,58 @@ static void
                                        stats_workspace2);
 
 
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_SetPlan
+** PURPOSE:       decide which years stats_Update computes in full
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Calibrating and testing read the records of the control
+**                years only. Predicting reads the record of every year,
+**                but only for the avg, std_dev and grow log files.
+**
+*/
+static void
+  stats_SetPlan ()
+{
+  plan.save_every_year = (proc_GetProcessingType () == PREDICTING) &&
+    (scen_GetWriteAvgFileFlag () || scen_GetWriteStdDevFileFlag () ||
+     scen_GetWriteGrowLogFlag ());
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_count_urban
+** PURPOSE:       count the urban pixels of Z
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   the area of stats_compute_stats, from the cumulative
+**                growth list when Z is the urban (Z) grid
+**
+*/
+static int
+  stats_count_urban (GRID_P Z)
+{
+  COORD_TYPE *row;
+  COORD_TYPE *col;
+  int count;
+  int k;
+
+  if (Z != mem_GetGRZpointer ())
+  {
+    return util_count_pixels (mem_GetTotalPixels (), Z, GT, 0);
+  }
+
+  row = (COORD_TYPE *) mem_GetGRZrowptr ();
+  col = (COORD_TYPE *) mem_GetGRZcolptr ();
+  count = 0;
+  for (k = 0; k < mem_GetGRZcount (); k++)
+  {
+    count += (Z[OFFSET (row[k], col[k])] != 0);
+  }
+  return count;
 }
 /******************************************************************************
 *******************************************************************************
@@ -1537,17 +1671,37 @@ void
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   with WRITE_RESULTS_STORE the line is a row of the
+**                results table instead (agent 10/19/2026).
 **
 */
 static void
-  stats_WriteStatsValLine (char *filename, int run, int year,
+  stats_WriteStatsValLine (char *filename, char *table, int run, int year,
                            stats_val_t * stats_ptr, int index)
 {
   char func[] = "stats_WriteStatsValLine";
+  char *names[3 + sizeof (stats_val_t) / sizeof (double)];
+  int ints[3];
+  int i;
   FILE *fp;
 
+  if (scen_GetWriteResultsStoreFlag ())
+  {
+    names[0] = "run";
+    names[1] = "year";
+    names[2] = "index";
+    for (i = 0; i < sizeof (stats_val_t) / sizeof (double); i++)
+    {
+      names[3 + i] = stats_val_t_names[i];
+    }
+    ints[0] = run;
+    ints[1] = year;
+    ints[2] = index;
+    rstore_AppendRow (rstore_DefineTable (table, 3 + i, names, 3), ints,
+                      (double *) &(stats_ptr[index]));
+    return;
+  }
+
   FILE_OPEN (fp, filename, "a");
 
   stats_LogStatVal (run, year, index, &(stats_ptr[index]), fp);
@@ -1781,7 +1935,6 @@ static void
                           double *leesalee)                /* OUT    */
 {
   char func[] = "stats_compute_leesalee";
-  int i;
   int the_union;
   int intersection;
 
@@ -1790,20 +1943,8 @@ static void
   assert (urban != NULL);
   assert (leesalee != NULL);
 
-  the_union = 0;
-  intersection = 0;
-  for (i = 0; i < mem_GetTotalPixels (); i++)
-  {
-    if ((Z[i] != 0) || (urban[i] != 0))
-    {
-      the_union++;
-    }
-
-    if ((Z[i] != 0) && (urban[i] != 0))
-    {
-      intersection++;
-    }
-  }
+  util_compare_grids (mem_GetTotalPixels (), Z, urban,
+                      &intersection, &the_union, NULL);
 
   *leesalee = (double) intersection / the_union;
   FUNC_END;
@@ -1835,14 +1976,16 @@ void
   static int avg_log_created = 0;
   static int std_dev_log_created = 0;
   static int control_stats_log_created = 0;
+  BOOLEAN store;
 
   output_dir = scen_GetOutputDir ();
   run = proc_GetCurrentRun ();
+  store = scen_GetWriteResultsStoreFlag ();
 
   if (scen_GetWriteAvgFileFlag ())
   {
     sprintf (avg_filename, "%savg_pe_%u.log", output_dir, glb_mype);
-    if (!avg_log_created)
+    if (!avg_log_created && !store)
     {
       stats_CreateStatsValFile (avg_filename);
       avg_log_created = 1;
@@ -1852,7 +1995,7 @@ void
   if (scen_GetWriteStdDevFileFlag ())
   {
     sprintf (std_filename, "%sstd_dev_pe_%u.log", output_dir, glb_mype);
-    if (!std_dev_log_created)
+    if (!std_dev_log_created && !store)
     {
       stats_CreateStatsValFile (std_filename);
       std_dev_log_created = 1;
@@ -1862,7 +2005,7 @@ void
   if (proc_GetProcessingType () != PREDICTING)
   {
     sprintf (cntrl_filename, "%scontrol_stats_pe_%u.csv", output_dir, glb_mype);
-    if (!control_stats_log_created)
+    if (!control_stats_log_created && !store)
     {
       stats_CreateControlFile (cntrl_filename);
       control_stats_log_created = 1;
@@ -1880,15 +2023,15 @@ void
     {
       yr = igrid_GetUrbanYear (i);
       stats_CalAverages (i);
-      stats_ProcessGrowLog (run, yr);
+      stats_CalStdDev (i, &moments[i]);
 
       if (scen_GetWriteAvgFileFlag ())
       {
-        stats_WriteStatsValLine (avg_filename, run, yr, average, i);
+        stats_WriteStatsValLine (avg_filename, "avg", run, yr, average, i);
       }
       if (scen_GetWriteStdDevFileFlag ())
       {
-        stats_WriteStatsValLine (std_filename, run, yr, std_dev, i);
+        stats_WriteStatsValLine (std_filename, "std_dev", run, yr, std_dev, i);
       }
     }
     stats_DoRegressions ();
@@ -1903,14 +2046,16 @@ void
 #if 1
       stats_ClearStatsValArrays ();
 #endif
-      stats_ProcessGrowLog (run, yr);
+      running_total[0] = moments[yr - scen_GetPredictionStartDate ()].sum;
+      stats_CalAverages (0);
+      stats_CalStdDev (0, &moments[yr - scen_GetPredictionStartDate ()]);
       if (scen_GetWriteAvgFileFlag ())
       {
-        stats_WriteStatsValLine (avg_filename, run, yr, average, 0);
+        stats_WriteStatsValLine (avg_filename, "avg", run, yr, average, 0);
       }
       if (scen_GetWriteStdDevFileFlag ())
       {
-        stats_WriteStatsValLine (std_filename, run, yr, std_dev, 0);
+        stats_WriteStatsValLine (std_filename, "std_dev", run, yr, std_dev, 0);
       }
 #if 1
       stats_ClearStatsValArrays ();
@@ -1918,6 +2063,7 @@ void
     }
   }
   stats_ClearStatsValArrays ();
+  stats_ClearMoments ();
 }
 /******************************************************************************
 *******************************************************************************
@@ -2412,15 +2558,35 @@ static void
 static void
   stats_Save (char *filename)
 {
-  char func[] = "stats_Save";
-  int num_written;
-  int fseek_loc;
-  int index;
-  int i;
-  FILE *fp;
   record.run = proc_GetCurrentRun ();
   record.monte_carlo = proc_GetCurrentMonteCarlo ();
   record.year = proc_GetCurrentYear ();
+
+  if (egrid_IsDeferredYear (record.year))
+  {
+    stats_DeferRecord ();
+    return;
+  }
+  stats_SaveRecord (filename);
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_SaveRecord
+** PURPOSE:       add record to the statistics of its year
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   record.run, record.monte_carlo and record.year must be
+**                set. Updates the running totals and the moments of the
+**                year, and dumps the record to the grow log filename
+**                with WRITE_GROW_LOG_FILES.
+**
+*/
+static void
+  stats_SaveRecord (char *filename)
+{
+  int index;
+
   index = 0;
   if (proc_GetProcessingType () != PREDICTING)
   {
@@ -2428,6 +2594,36 @@ static void
   }
 
   stats_UpdateRunningTotal (index);
+  if (proc_GetProcessingType () == PREDICTING)
+  {
+    index = record.year - scen_GetPredictionStartDate ();
+  }
+  stats_UpdateMoments (index);
+
+  if (scen_GetWriteGrowLogFlag ())
+  {
+    stats_WriteGrowLog (filename);
+  }
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_WriteGrowLog
+** PURPOSE:       write record into its slot of the grow log filename
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Only done with WRITE_GROW_LOG_FILES, for debugging; the
+**                files are no longer read back nor removed.
+**
+*/
+static void
+  stats_WriteGrowLog (char *filename)
+{
+  char func[] = "stats_WriteGrowLog";
+  int num_written;
+  int fseek_loc;
+  int i;
+  FILE *fp;
 
   if (record.monte_carlo == 0)
   {
@@ -2459,97 +2655,177 @@ static void
 }
 /******************************************************************************
 *******************************************************************************
-** FUNCTION NAME: stats_ProcessGrowLog
-** PURPOSE:       
-** AUTHOR:        Keith Clarke
-** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
-** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** FUNCTION NAME: stats_ClearMoments
+** PURPOSE:       clear the moments of every year
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The moments are allocated by the first call, for the
+**                control years and for the prediction years.
 **
 */
 static void
-  stats_ProcessGrowLog (int run, int year)
+  stats_ClearMoments ()
 {
-  char func[] = "stats_ProcessGrowLog";
-  FILE *fp;
-  int index;
-  int fseek_loc;
-  int i;
-  int mc_count = 0;
-  char filename[MAX_FILENAME_LEN];
-  char command[MAX_FILENAME_LEN + 3];
-
-  sprintf (filename, "%sgrow_%u_%u.log", scen_GetOutputDir (), run, year);
-  sprintf (command, "rm %s", filename);
+  char func[] = "stats_ClearMoments";
 
-  FILE_OPEN (fp, filename, "rb");
-
-  if (proc_GetProcessingType () != PREDICTING)
+  if (moments == NULL)
   {
-    while (fread (&record, sizeof (record), 1, fp))
+    num_moments = scen_GetPredictionStopDate () -
+      scen_GetPredictionStartDate () + 1;
+    if (num_moments < MAX_URBAN_YEARS)
     {
-      if (mc_count >= scen_GetMonteCarloIterations ())
-      {
-        sprintf (msg_buf, "mc_count >= scen_GetMonteCarloIterations ()");
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      if (feof (fp) || ferror (fp))
-      {
-        sprintf (msg_buf, "feof (fp) || ferror (fp)");
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      index = igrid_UrbanYear2Index (year);
-      stats_CalStdDev (index);
-      mc_count++;
+      num_moments = MAX_URBAN_YEARS;
+    }
+    moments = malloc (num_moments * sizeof (stats_moments));
+    if (moments == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory",
+               (unsigned int) (num_moments * sizeof (stats_moments)));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
     }
   }
-  else
+  memset ((void *) moments, 0, num_moments * sizeof (stats_moments));
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_UpdateMoments
+** PURPOSE:       add record.this_year to the moments of index
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Welford's update of the mean and of the sum of squared
+**                deviations; the plain sum is kept too so that the
+**                prediction averages add up in the same order as the
+**                calibration running totals.
+**
+*/
+static void
+  stats_UpdateMoments (int index)
+{
+  char func[] = "stats_UpdateMoments";
+  stats_moments *moment;
+  double *x;
+  double *sum;
+  double *mean;
+  double *m2;
+  double delta;
+  int k;
+
+  if ((index < 0) || (index >= num_moments))
   {
-    while (fread (&record, sizeof (record), 1, fp))
+    sprintf (msg_buf, "no moments for year %d", record.year);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  moment = &moments[index];
+  x = (double *) &record.this_year;
+  sum = (double *) &moment->sum;
+  mean = (double *) &moment->mean;
+  m2 = (double *) &moment->m2;
+
+  moment->count++;
+  for (k = 0; k < STATS_VAL_COUNT; k++)
+  {
+    sum[k] += x[k];
+    delta = x[k] - mean[k];
+    mean[k] += delta / moment->count;
+    m2[k] += delta * (x[k] - mean[k]);
+  }
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_DeferRecord
+** PURPOSE:       keep a control year record until its ensemble counts
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The edges and the Lee-Sallee index of the record are
+**                left to stats_FlushEnsemble; the Z grid is deposited in
+**                the replicate's bit-plane of the year's ensemble grid.
+**
+*/
+static void
+  stats_DeferRecord ()
+{
+  char func[] = "stats_DeferRecord";
+  int index;
+  int replicate;
+
+  index = igrid_UrbanYear2Index (record.year);
+  replicate = record.monte_carlo % EGRID_REPLICATES;
+  if (replicate != ensemble_record_count[index])
+  {
+    sprintf (msg_buf, "monte carlo %d of year %d is out of sequence",
+             record.monte_carlo, record.year);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  egrid_Deposit (index,                                      /* IN     */
+                 replicate,                                  /* IN     */
+                 pgrid_GetZPtr (),                           /* IN     */
+                 zgrwth_row,                                 /* IN     */
+                 zgrwth_col,                                 /* IN     */
+                 zgrwth_count);                            /* IN     */
+  ensemble_record[index][replicate] = record;
+  ensemble_record_count[index]++;
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_FlushEnsemble
+** PURPOSE:       complete and save the deferred control year records
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Called by the Monte Carlo loop after every group of
+**                EGRID_REPLICATES replicates and after the last one. The
+**                edge and Lee-Sallee counts of the whole group are taken
+**                from the ensemble grid of each control year, then the
+**                records are saved in Monte Carlo order, as stats_Save
+**                would have done.
+**
+*/
+void
+  stats_FlushEnsemble ()
+{
+  char func[] = "stats_FlushEnsemble";
+  char filename[MAX_FILENAME_LEN];
+  int area[EGRID_REPLICATES];
+  int edges[EGRID_REPLICATES];
+  int intersection[EGRID_REPLICATES];
+  int the_union[EGRID_REPLICATES];
+  int index;
+  int r;
+
+  FUNC_INIT;
+  for (index = 1; index < igrid_GetUrbanCount (); index++)
+  {
+    if (ensemble_record_count[index] == 0)
     {
-      if (mc_count >= scen_GetMonteCarloIterations ())
-      {
-        sprintf (msg_buf, "mc_count >= scen_GetMonteCarloIterations ()");
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      if (feof (fp) || ferror (fp))
-      {
-        sprintf (msg_buf, "feof (fp) || ferror (fp)");
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      stats_UpdateRunningTotal (0);
+      continue;
     }
-    stats_CalAverages (0);
-    rewind (fp);
-    mc_count = 0;
-    while (fread (&record, sizeof (record), 1, fp))
+    egrid_CountStats (index,                                 /* IN     */
+                      ensemble_record_count[index],          /* IN     */
+                      area,                                  /* OUT    */
+                      edges,                                 /* OUT    */
+                      intersection,                          /* OUT    */
+                      the_union);                          /* OUT    */
+
+    for (r = 0; r < ensemble_record_count[index]; r++)
     {
-      if (mc_count >= scen_GetMonteCarloIterations ())
-      {
-        sprintf (msg_buf, "mc_count >= scen_GetMonteCarloIterations ()");
-        LOG_ERROR (msg_buf);
-        sprintf (msg_buf, "mc_count= %u scen_GetMonteCarloIterations= %u",
-                 mc_count, scen_GetMonteCarloIterations ());
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      if (feof (fp) || ferror (fp))
-      {
-        sprintf (msg_buf, "feof (fp) || ferror (fp)");
-        LOG_ERROR (msg_buf);
-        EXIT (1);
-      }
-      stats_CalStdDev (0);
-      mc_count++;
+      record = ensemble_record[index][r];
+      assert ((int) record.this_year.area == area[r]);
+      record.this_year.edges = edges[r];
+      record.this_year.leesalee = (double) intersection[r] / the_union[r];
+      sprintf (filename, "%sgrow_%u_%u.log",
+               scen_GetOutputDir (), record.run, record.year);
+      stats_SaveRecord (filename);
     }
+    ensemble_record_count[index] = 0;
   }
-  fclose (fp);
-  system (command);
+  FUNC_END;
 }
 /******************************************************************************
 *******************************************************************************
@@ -2680,36 +2956,47 @@ static void
   char func[] = "stats_ComputeBaseStats";
   int i;
   int total_pixels;
-  GRID_P urban_ptr;
+  GRID_P urban_ptr[MAX_URBAN_YEARS];
   GRID_P slope_ptr;
-  GRID_P stats_workspace1;
-  GRID_P stats_workspace2;
   int road_pixel_count;
   int excluded_pixel_count;
 
   total_pixels = mem_GetTotalPixels ();
   assert (total_pixels > 0);
 
+  slope_ptr = igrid_GetSlopeGridPtr (__FILE__, func, __LINE__);
+  for (i = 0; i < igrid_GetUrbanCount (); i++)
+  {
+    urban_ptr[i] = igrid_GetUrbanGridPtr (__FILE__, func, __LINE__, i);
+  }
+
+  /*
+   *
+   * the control grids are independent: one thread each (OpenMP)
+   *
+   */
+#pragma omp parallel for schedule(dynamic)
+  for (i = 0; i < igrid_GetUrbanCount (); i++)
+  {
+    stats_base_sweep (urban_ptr[i],                          /* IN     */
+                      slope_ptr,                             /* IN     */
+                      &stats_actual[i]);                   /* OUT    */
+  }
+
   for (i = 0; i < igrid_GetUrbanCount (); i++)
   {
-    urban_ptr = igrid_GetUrbanGridPtr (__FILE__, func, __LINE__, i);
-    slope_ptr = igrid_GetSlopeGridPtr (__FILE__, func, __LINE__);
-    stats_workspace1 = mem_GetWGridPtr (__FILE__, func, __LINE__);
-    stats_workspace2 = mem_GetWGridPtr (__FILE__, func, __LINE__);
-
-    stats_compute_stats (urban_ptr,                          /* IN     */
-                         slope_ptr,                          /* IN     */
-                         &stats_actual[i].area,              /* OUT    */
-                         &stats_actual[i].edges,             /* OUT    */
-                         &stats_actual[i].clusters,          /* OUT    */
-                         &stats_actual[i].pop,               /* OUT    */
-                         &stats_actual[i].xmean,             /* OUT    */
-                         &stats_actual[i].ymean,             /* OUT    */
-                         &stats_actual[i].average_slope,     /* OUT    */
-                         &stats_actual[i].rad,               /* OUT    */
-                         &stats_actual[i].mean_cluster_size,   /* OUT    */
-                         stats_workspace1,                   /* MOD    */
-                         stats_workspace2);                /* MOD    */
+    if (stats_actual[i].clusters <= 0)
+    {
+      sprintf (msg_buf, "num_clusters=%d", (int) stats_actual[i].clusters);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+    if (stats_actual[i].area <= 0)
+    {
+      sprintf (msg_buf, "number = %d", (int) stats_actual[i].area);
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
 
     road_pixel_count = igrid_GetIGridRoadPixelCount (proc_GetCurrentYear ());
     excluded_pixel_count = igrid_GetIGridExcludedPixelCount ();
@@ -2728,14 +3015,141 @@ static void
     /*VerD*/
 
 
-    urban_ptr = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr);
-    slope_ptr = igrid_GridRelease (__FILE__, func, __LINE__, slope_ptr);
-    stats_workspace1 = mem_GetWGridFree (__FILE__, func, __LINE__,
-                                         stats_workspace1);
-    stats_workspace2 = mem_GetWGridFree (__FILE__, func, __LINE__,
-                                         stats_workspace2);
+    urban_ptr[i] = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr[i]);
+  }
+  slope_ptr = igrid_GridRelease (__FILE__, func, __LINE__, slope_ptr);
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_base_sweep
+** PURPOSE:       compute the statistics of an input urban grid in one pass
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   The results of stats_edge, stats_cluster and stats_circle,
+**                with the clusters of interior urban pixels joined (union
+**                by size) to their W and N neighbours as the raster is
+**                scanned. Uses no static memory, so that the control
+**                grids can be swept on separate threads; the clusters and
+**                area are checked by the caller.
+*/
+static void
+  stats_base_sweep (GRID_P urban,                            /* IN     */
+                    GRID_P slp,                              /* IN     */
+                    stats_info * actual)                   /* OUT    */
+{
+  char func[] = "stats_base_sweep";
+  grid_view Z;
+  grid_view slope;
+  int *parent;
+  int i;
+  int j;
+  int offset;
+  int loop;
+  int row;
+  int col;
+  int rowi[4] = {-1, 1, 0, 0};
+  int colj[4] = {0, 0, -1, 1};
+  int edge;
+  int edges;
+  int area;
+  int num_clusters;
+  int sum;
+  double xmean;
+  double ymean;
+  double addslope;
+
+  assert (urban != NULL);
+  assert (slp != NULL);
+  assert (actual != NULL);
+  grid_SetView (&Z, urban);
+  grid_SetView (&slope, slp);
+
+  parent = calloc (Z.nrows * Z.ncols, sizeof (int));
+  if (parent == NULL)
+  {
+    sprintf (msg_buf, "Unable to allocate %u bytes of memory",
+             (unsigned int) (Z.nrows * Z.ncols * sizeof (int)));
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  edges = 0;
+  area = 0;
+  num_clusters = 0;
+  sum = 0;
+  xmean = 0.0;
+  ymean = 0.0;
+  addslope = 0.0;
+  for (i = 0; i < Z.nrows; i++)
+  {
+    for (j = 0; j < Z.ncols; j++)
+    {
+      offset = GV_OFFSET (&Z, i, j);
+      if (Z.ptr[offset] == 0)
+      {
+        continue;
+      }
+
+      area++;
+      addslope += GV_PIXEL (&slope, i, j);
+      xmean += (double) j;
+      ymean += (double) i;
+
+      edge = FALSE;
+      for (loop = 0; loop <= 3; loop++)
+      {
+        row = i + rowi[loop];
+        col = j + colj[loop];
+        if (GV_IMAGE_PT (&Z, row, col) && (GV_PIXEL (&Z, row, col) == 0))
+        {
+          edge = TRUE;
+        }
+      }
+      if (edge)
+      {
+        edges++;
+      }
 
+      if (GV_INTERIOR_PT (&Z, i, j))
+      {
+        parent[offset] = -1;
+        num_clusters++;
+        sum++;
+        if ((parent[GV_OFFSET (&Z, i, j - 1)] != 0) &&
+            stats_cluster_union (parent, offset, GV_OFFSET (&Z, i, j - 1)))
+        {
+          num_clusters--;
+        }
+        if ((parent[GV_OFFSET (&Z, i - 1, j)] != 0) &&
+            stats_cluster_union (parent, offset, GV_OFFSET (&Z, i - 1, j)))
+        {
+          num_clusters--;
+        }
+      }
+    }
+  }
+  free (parent);
+
+  actual->area = area;
+  actual->edges = edges;
+  actual->pop = area;
+  actual->clusters = num_clusters;
+  actual->mean_cluster_size = 0;
+  if (num_clusters > 0)
+  {
+    actual->mean_cluster_size = sum / num_clusters;
+  }
+  actual->xmean = 0.0;
+  actual->ymean = 0.0;
+  actual->average_slope = 0.0;
+  if (area > 0)
+  {
+    actual->xmean = xmean / (double) area;
+    actual->ymean = ymean / (double) area;
+    actual->average_slope = addslope / area;
   }
+  actual->rad = pow ((area / PI), 0.5);
 }
 /******************************************************************************
 *******************************************************************************
@@ -2744,8 +3158,9 @@ static void
 ** AUTHOR:        Keith Clarke
 ** PROGRAMMER:    Tommy E. Cathey of NESC (919)541-1500
 ** CREATION DATE: 11/11/1999
-** DESCRIPTION:
-**
+** DESCRIPTION:   The urban (Z) grid is handled by stats_sweep, which also
+**                leaves the Lee-Sallee counts for stats_CalLeesalee; the
+**                input urban grids go through the separate passes.
 **
 */
 static void
@@ -2765,6 +3180,14 @@ static void
 
 {
   char func[] = "stats_compute_stats";
+  grid_view z_view;
+  grid_view slp_view;
+  GRID_P urban_ptr;
+  BOOLEAN deferred;
+  int year;
+  int area;
+  int edges;
+  int intersection;
 
   FUNC_INIT;
   assert (Z != NULL);
@@ -2782,17 +3205,71 @@ static void
   assert (scratch_gif2 != NULL);
 
 /** D. Donato 8/21/2006 Added to deal with cumulative growth                 **/
-  zgrwth_row = (short *)  mem_GetGRZrowptr();
-  zgrwth_col = (short *)  mem_GetGRZcolptr();
+  zgrwth_row = (COORD_TYPE *)  mem_GetGRZrowptr();
+  zgrwth_col = (COORD_TYPE *)  mem_GetGRZcolptr();
   zgrwth_count =          mem_GetGRZcount();
 /******************* 8/21/2006  ***********************************************/
 
+  grid_SetView (&z_view, Z);
+  grid_SetView (&slp_view, slp);
+
+  if (Z == mem_GetGRZpointer ())
+  {
+    /*
+     *
+     * the urban (Z) grid: one sweep of the urban pixel list computes
+     * everything, including the Lee-Sallee counts of urban years
+     *
+     */
+    year = proc_GetCurrentYear ();
+    deferred = egrid_IsDeferredYear (year);
+    urban_ptr = NULL;
+    if (igrid_TestForUrbanYear (year) &&
+        (proc_GetProcessingType () != PREDICTING) && !deferred)
+    {
+      urban_ptr = igrid_GetUrbanGridPtrByYear (__FILE__, func, __LINE__,
+                                               year);
+    }
+
+    stats_sweep (&z_view,                                    /* IN     */
+                 &slp_view,                                  /* IN     */
+                 urban_ptr,                                  /* IN     */
+                 !deferred && !scen_GetPackedUrbanGridFlag (), /* IN     */
+                 stats_area,                                 /* OUT    */
+                 stats_edges,                                /* OUT    */
+                 stats_clusters,                             /* OUT    */
+                 stats_pop,                                  /* OUT    */
+                 stats_xmean,                                /* OUT    */
+                 stats_ymean,                                /* OUT    */
+                 stats_average_slope,                        /* OUT    */
+                 stats_rad,                                  /* OUT    */
+                 stats_mean_cluster_size,                    /* OUT    */
+                 &intersection);                           /* OUT    */
+
+    if (scen_GetPackedUrbanGridFlag ())
+    {
+      bgrid_CountEdges (bgrid_GetZBitsPtr (), &area, &edges);
+      *stats_edges = edges;
+    }
+
+    if (urban_ptr != NULL)
+    {
+      leesalee_intersection = intersection;
+      leesalee_union = (int) *stats_area +
+        (int) stats_actual[igrid_UrbanYear2Index (year)].area - intersection;
+      leesalee_counted = TRUE;
+      urban_ptr = igrid_GridRelease (__FILE__, func, __LINE__, urban_ptr);
+    }
+    FUNC_END;
+    return;
+  }
+
   /*
    *
    * compute the number of edge pixels
    *
    */
-  stats_edge (Z,                                             /* IN     */
+  stats_edge (&z_view,                                       /* IN     */
               stats_area,                                    /* OUT    */
               stats_edges);                                /* OUT    */
 
@@ -2802,7 +3279,7 @@ static void
    * compute the number of clusters
    *
    */
-  stats_cluster (Z,                                          /* IN     */
+  stats_cluster (&z_view,                                    /* IN     */
                  stats_clusters,                             /* OUT    */
                  stats_pop,                                  /* OUT    */
                  stats_mean_cluster_size,                    /* OUT    */
@@ -2814,8 +3291,8 @@ static void
    * compute means
    *
    */
-  stats_circle (Z,                                           /* IN     */
-                slp,                                         /* IN     */
+  stats_circle (&z_view,                                     /* IN     */
+                &slp_view,                                   /* IN     */
                 *stats_area,                                 /* IN     */
                 stats_xmean,                                 /* OUT    */
                 stats_ymean,                                 /* OUT    */
@@ -2836,7 +3313,7 @@ static void
 **
 */
 static void
-  stats_edge (GRID_P Z,                                      /* IN     */
+  stats_edge (grid_view * Z,                                 /* IN     */
               double *stats_area,                            /* OUT    */
               double *stats_edges)                         /* OUT    */
 {
@@ -2854,13 +3331,14 @@ static void
   int col;
   int nrows;
   int ncols;
+  BOOLEAN count_edges;
 
   FUNC_INIT;
   assert (stats_area != NULL);
   assert (stats_edges != NULL);
   assert (Z != NULL);
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = Z->nrows;
+  ncols = Z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
 
@@ -2878,8 +3356,16 @@ static void
 
 *********************     8/21/2006    **************************/
 
- if (Z == mem_GetGRZpointer())
+ if (Z->ptr == mem_GetGRZpointer() && scen_GetPackedUrbanGridFlag ())
  {
+    bgrid_CountEdges (bgrid_GetZBitsPtr (), &area, &edges);
+ }
+
+ else if (Z->ptr == mem_GetGRZpointer())
+ {
+    /* the edges of ensemble years are counted by stats_FlushEnsemble */
+    count_edges = !egrid_IsDeferredYear (proc_GetCurrentYear ());
+
     for ( k = 0; k < zgrwth_count; k++)
     {
       i = zgrwth_row[k];
@@ -2887,9 +3373,13 @@ static void
 
       edge = FALSE;
 
-      if (Z[OFFSET (i, j)] != 0)
+      if (GV_PIXEL (Z, i, j) != 0)
       {
         area++;
+        if (!count_edges)
+        {
+          continue;
+        }
 
         /* this does a 4 neighbor search (N, S, E, W) */
         for (loop = 0; loop <= 3; loop++)
@@ -2897,9 +3387,9 @@ static void
           row = i + rowi[loop];
           col = j + colj[loop];
 
-          if (IMAGE_PT (row, col))
+          if (GV_IMAGE_PT (Z, row, col))
           {
-            if (Z[OFFSET (row, col)] == 0)
+            if (GV_PIXEL (Z, row, col) == 0)
             {
               edge = TRUE;
             }
@@ -2923,7 +3413,7 @@ static void
     {
       edge = FALSE;
 
-      if (Z[OFFSET (i, j)] != 0)
+      if (GV_PIXEL (Z, i, j) != 0)
       {
         area++;
 
@@ -2933,9 +3423,9 @@ static void
           row = i + rowi[loop];
           col = j + colj[loop];
 
-          if (IMAGE_PT (row, col))
+          if (GV_IMAGE_PT (Z, row, col))
           {
-            if (Z[OFFSET (row, col)] == 0)
+            if (GV_PIXEL (Z, row, col) == 0)
             {
               edge = TRUE;
             }
@@ -2967,8 +3457,8 @@ static void
 **
 */
 static void
-  stats_circle (GRID_P Z,                                    /* IN     */
-                GRID_P slp,                                  /* IN     */
+  stats_circle (grid_view * Z,                               /* IN     */
+                grid_view * slp,                             /* IN     */
                 int stats_area,                              /* IN     */
                 double *stats_xmean,                         /* OUT    */
                 double *stats_ymean,                         /* OUT    */
@@ -2994,8 +3484,8 @@ static void
   assert (Z != NULL);
   assert (slp != NULL);
 
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = Z->nrows;
+  ncols = Z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
   addslope = 0.0;
@@ -3022,7 +3512,7 @@ static void
 *********************     8/21/2006    **************************/
 
 
- if (Z == mem_GetGRZpointer())
+ if (Z->ptr == mem_GetGRZpointer())
  {
 
     for ( k = 0; k < zgrwth_count; k++)
@@ -3030,9 +3520,9 @@ static void
       i = zgrwth_row[k];
       j = zgrwth_col[k];
 
-      if (Z[OFFSET (i, j)] > 0)
+      if (GV_PIXEL (Z, i, j) > 0)
       {
-        addslope += slp[OFFSET (i, j)];
+        addslope += GV_PIXEL (slp, i, j);
         xmean += (double) j;
         ymean += (double) i;
         number++;
@@ -3047,9 +3537,9 @@ static void
   {
     for (j = 0; j < ncols; j++)
     {
-      if (Z[OFFSET (i, j)] > 0)
+      if (GV_PIXEL (Z, i, j) > 0)
       {
-        addslope += slp[OFFSET (i, j)];
+        addslope += GV_PIXEL (slp, i, j);
         xmean += (double) j;
         ymean += (double) i;
         number++;
@@ -3100,7 +3590,11 @@ void
   LOG_MEM (fp, &average[0], sizeof (stats_val_t), MAX_URBAN_YEARS);
   LOG_MEM (fp, &std_dev[0], sizeof (stats_val_t), MAX_URBAN_YEARS);
   LOG_MEM (fp, &running_total[0], sizeof (stats_val_t), MAX_URBAN_YEARS);
+  LOG_MEM (fp, &moments, sizeof (stats_moments *), 1);
   LOG_MEM (fp, &urbanization_attempt, sizeof (urbanization_attempt), 1);
+  LOG_MEM (fp, &ensemble_record[0][0], sizeof (stats_record),
+           MAX_URBAN_YEARS * EGRID_REPLICATES);
+  LOG_MEM (fp, &ensemble_record_count[0], sizeof (int), MAX_URBAN_YEARS);
 }
 /******************************************************************************
 *******************************************************************************
@@ -3114,7 +3608,7 @@ void
 **
 */
 static void
-  stats_cluster (GRID_P Z,                                   /* IN     */
+  stats_cluster (grid_view * Z,                              /* IN     */
                  double *stats_clusters,                     /* OUT    */
                  double *stats_pop,                          /* OUT    */
                  double *stats_mean_cluster_size,            /* OUT    */
@@ -3154,8 +3648,8 @@ static void
   assert (scratch_gif2 != NULL);
   total_pixels = mem_GetTotalPixels ();
   assert (total_pixels > 0);
-  nrows = igrid_GetNumRows ();
-  ncols = igrid_GetNumCols ();
+  nrows = Z->nrows;
+  ncols = Z->ncols;
   assert (nrows > 0);
   assert (ncols > 0);
 
@@ -3174,7 +3668,7 @@ static void
   for (i = 0; i < total_pixels; i++)
   {
 *** D.D. 8/21/2006                        *********************************/
-    if (Z[i] != 0)
+    if (Z->ptr[i] != 0)
     {
       clusters[i] = 1;
       (*stats_pop)++;
@@ -3186,13 +3680,13 @@ static void
   }
   for (j = 0; j < ncols; j++)
   {
-    clusters[OFFSET (0, j)] = 0;
-    clusters[OFFSET (nrows - 1, j)] = 0;
+    clusters[GV_OFFSET (Z, 0, j)] = 0;
+    clusters[GV_OFFSET (Z, nrows - 1, j)] = 0;
   }
   for (i = 0; i < nrows; i++)
   {
-    clusters[OFFSET (i, 0)] = 0;
-    clusters[OFFSET (i, ncols - 1)] = 0;
+    clusters[GV_OFFSET (Z, i, 0)] = 0;
+    clusters[GV_OFFSET (Z, i, ncols - 1)] = 0;
   }
 
 
@@ -3207,19 +3701,19 @@ static void
 
 *********************     8/21/2006    **************************/
 
- if (Z == mem_GetGRZpointer())
+ if (Z->ptr == mem_GetGRZpointer())
  {
     for ( k = 0; k < zgrwth_count; k++)
     {
       i = zgrwth_row[k];
       j = zgrwth_col[k];
       
-      if (clusters[OFFSET (i, j)] == 1 && visited[OFFSET (i, j)] == 0)
+      if (clusters[GV_OFFSET (Z, i, j)] == 1 && visited[GV_OFFSET (Z, i, j)] == 0)
       {
         sum++;
         rrow = i;
         ccol = j;
-        visited[OFFSET (i, j)] = 1;
+        visited[GV_OFFSET (Z, i, j)] = 1;
         Q_STORE (rrow, ccol);
         do
         {
@@ -3229,12 +3723,12 @@ static void
             rrow = row + rowi[loop];
             ccol = col + colj[loop];
 
-            if (IMAGE_PT (rrow, ccol))
+            if (GV_IMAGE_PT (Z, rrow, ccol))
             {
-              if (clusters[OFFSET (rrow, ccol)] == 1 &&
-                  !visited[OFFSET (rrow, ccol)])
+              if (clusters[GV_OFFSET (Z, rrow, ccol)] == 1 &&
+                  !visited[GV_OFFSET (Z, rrow, ccol)])
               {
-                visited[OFFSET (rrow, ccol)] = 1;
+                visited[GV_OFFSET (Z, rrow, ccol)] = 1;
                 Q_STORE (rrow, ccol);
 
                 sum++;
@@ -3256,12 +3750,12 @@ static void
   {
     for (j = 0; j < ncols; j++)
     {
-      if (clusters[OFFSET (i, j)] == 1 && visited[OFFSET (i, j)] == 0)
+      if (clusters[GV_OFFSET (Z, i, j)] == 1 && visited[GV_OFFSET (Z, i, j)] == 0)
       {
         sum++;
         rrow = i;
         ccol = j;
-        visited[OFFSET (i, j)] = 1;
+        visited[GV_OFFSET (Z, i, j)] = 1;
         Q_STORE (rrow, ccol);
         do
         {
@@ -3271,12 +3765,12 @@ static void
             rrow = row + rowi[loop];
             ccol = col + colj[loop];
 
-            if (IMAGE_PT (rrow, ccol))
+            if (GV_IMAGE_PT (Z, rrow, ccol))
             {
-              if (clusters[OFFSET (rrow, ccol)] == 1 &&
-                  !visited[OFFSET (rrow, ccol)])
+              if (clusters[GV_OFFSET (Z, rrow, ccol)] == 1 &&
+                  !visited[GV_OFFSET (Z, rrow, ccol)])
               {
-                visited[OFFSET (rrow, ccol)] = 1;
+                visited[GV_OFFSET (Z, rrow, ccol)] = 1;
                 Q_STORE (rrow, ccol);
 
                 sum++;
@@ -3307,6 +3801,322 @@ static void
 }
 /******************************************************************************
 *******************************************************************************
+** FUNCTION NAME: stats_sweep
+** PURPOSE:       compute the statistics of the urban (Z) grid in one sweep
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Fuses stats_edge, stats_circle and the Lee-Sallee
+**                counts over the cumulative growth list, which holds every
+**                urban pixel of Z once. The clusters come from the
+**                union-find kept by stats_add_clusters. intersection is
+**                only counted when urban is not NULL. The sums run in list
+**                order, so the results are those of the separate passes.
+*/
+static void
+  stats_sweep (grid_view * Z,                                /* IN     */
+               grid_view * slp,                              /* IN     */
+               GRID_P urban,                                 /* IN     */
+               BOOLEAN count_edges,                          /* IN     */
+               double *stats_area,                           /* OUT    */
+               double *stats_edges,                          /* OUT    */
+               double *stats_clusters,                       /* OUT    */
+               double *stats_pop,                            /* OUT    */
+               double *stats_xmean,                          /* OUT    */
+               double *stats_ymean,                          /* OUT    */
+               double *stats_average_slope,                  /* OUT    */
+               double *stats_rad,                            /* OUT    */
+               double *stats_mean_cluster_size,              /* OUT    */
+               int *intersection)                          /* OUT    */
+{
+  char func[] = "stats_sweep";
+  int i;
+  int j;
+  int k;
+  int offset;
+  int edge;
+  int edges;
+  int area;
+  int row;
+  int col;
+  int rowi[4] = {-1, 1, 0, 0};
+  int colj[4] = {0, 0, -1, 1};
+  int loop;
+  int hits;
+  double xmean;
+  double ymean;
+  double addslope;
+
+  FUNC_INIT;
+  assert (Z != NULL);
+  assert (slp != NULL);
+  assert (intersection != NULL);
+
+  edges = 0;
+  area = 0;
+  hits = 0;
+  addslope = 0.0;
+  xmean = 0.0;
+  ymean = 0.0;
+  stats_add_clusters (Z);
+
+  for (k = 0; k < zgrwth_count; k++)
+  {
+    i = zgrwth_row[k];
+    j = zgrwth_col[k];
+    offset = GV_OFFSET (Z, i, j);
+
+    if (Z->ptr[offset] == 0)
+    {
+      continue;
+    }
+
+    /*
+     *
+     * area, means and slope
+     *
+     */
+    area++;
+    addslope += GV_PIXEL (slp, i, j);
+    xmean += (double) j;
+    ymean += (double) i;
+    if ((urban != NULL) && (urban[offset] != 0))
+    {
+      hits++;
+    }
+
+    /*
+     *
+     * edge pixels (4 neighbor search: N, S, E, W)
+     *
+     */
+    if (count_edges)
+    {
+      edge = FALSE;
+      for (loop = 0; loop <= 3; loop++)
+      {
+        row = i + rowi[loop];
+        col = j + colj[loop];
+
+        if (GV_IMAGE_PT (Z, row, col))
+        {
+          if (GV_PIXEL (Z, row, col) == 0)
+          {
+            edge = TRUE;
+          }
+        }
+      }
+      if (edge)
+      {
+        edges++;
+      }
+    }
+  }
+
+  *stats_area = area;
+  *stats_edges = edges;
+  *stats_pop = area;
+  *intersection = hits;
+
+  *stats_clusters = cluster_count;
+  if (cluster_count > 0)
+  {
+    *stats_mean_cluster_size = cluster_pixels / cluster_count;
+  }
+  else
+  {
+    sprintf (msg_buf, "num_clusters=%d", cluster_count);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  if (area <= 0)
+  {
+    sprintf (msg_buf, "number = %d", area);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+  *stats_xmean = xmean / (double) area;
+  *stats_ymean = ymean / (double) area;
+  *stats_average_slope = addslope / area;
+  *stats_rad = pow ((area / PI), 0.5);
+
+  FUNC_END;
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_InitClusters
+** PURPOSE:       empty the cluster union-find
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Called by grw_grow before it resets the cumulative growth
+**                list; only the pixels of the old list are cleared.
+**
+**
+*/
+void
+  stats_InitClusters ()
+{
+  char func[] = "stats_InitClusters";
+  COORD_TYPE *row;
+  COORD_TYPE *col;
+  int k;
+
+  if (cluster_parent == NULL)
+  {
+    cluster_parent = calloc (mem_GetTotalPixels (), sizeof (int));
+    if (cluster_parent == NULL)
+    {
+      sprintf (msg_buf, "Unable to allocate %u bytes of memory",
+               (unsigned int) (mem_GetTotalPixels () * sizeof (int)));
+      LOG_ERROR (msg_buf);
+      EXIT (1);
+    }
+  }
+  else
+  {
+    row = (COORD_TYPE *) mem_GetGRZrowptr ();
+    col = (COORD_TYPE *) mem_GetGRZcolptr ();
+    for (k = 0; k < cluster_added; k++)
+    {
+      cluster_parent[OFFSET (row[k], col[k])] = 0;
+    }
+  }
+  cluster_added = 0;
+  cluster_count = 0;
+  cluster_pixels = 0;
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_add_clusters
+** PURPOSE:       add the new pixels of the cumulative growth list
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Urban pixels are only added during an iteration, so each
+**                new interior pixel starts a cluster and is merged (union
+**                by size) with its interior urban N, S, E, W neighbours.
+**                cluster_count and cluster_pixels are then the cluster
+**                count and size sum of stats_cluster.
+*/
+static void
+  stats_add_clusters (grid_view * Z)
+{
+  char func[] = "stats_add_clusters";
+  int rowi[4] = {-1, 1, 0, 0};
+  int colj[4] = {0, 0, -1, 1};
+  int loop;
+  int i;
+  int j;
+  int k;
+  int offset;
+  int neighbor;
+
+  if (cluster_parent == NULL)
+  {
+    stats_InitClusters ();
+  }
+  if (zgrwth_count < cluster_added)
+  {
+    sprintf (msg_buf, "growth list shrank from %d to %d pixels",
+             cluster_added, zgrwth_count);
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
+
+  for (k = cluster_added; k < zgrwth_count; k++)
+  {
+    i = zgrwth_row[k];
+    j = zgrwth_col[k];
+    offset = GV_OFFSET (Z, i, j);
+    if (!GV_INTERIOR_PT (Z, i, j) || (Z->ptr[offset] == 0))
+    {
+      continue;
+    }
+
+    cluster_parent[offset] = -1;
+    cluster_count++;
+    cluster_pixels++;
+
+    for (loop = 0; loop <= 3; loop++)
+    {
+      neighbor = GV_OFFSET (Z, i + rowi[loop], j + colj[loop]);
+      if (cluster_parent[neighbor] == 0)
+      {
+        continue;
+      }
+      if (stats_cluster_union (cluster_parent, offset, neighbor))
+      {
+        cluster_count--;
+      }
+    }
+  }
+  cluster_added = zgrwth_count;
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_cluster_root
+** PURPOSE:       find the root of the cluster of offset
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   with path halving; parent is encoded as cluster_parent
+**
+**
+*/
+static int
+  stats_cluster_root (int *parent, int offset)
+{
+  int up;
+
+  while (parent[offset] > 0)
+  {
+    up = parent[offset];
+    if (parent[up] > 0)
+    {
+      parent[offset] = parent[up];
+    }
+    offset = up;
+  }
+  return offset;
+}
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: stats_cluster_union
+** PURPOSE:       merge the clusters of a and b
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Union by size. Returns FALSE when a and b already are in
+**                the same cluster.
+**
+*/
+static BOOLEAN
+  stats_cluster_union (int *parent, int a, int b)
+{
+  int root;
+  int other;
+  int swap;
+
+  root = stats_cluster_root (parent, a);
+  other = stats_cluster_root (parent, b);
+  if (root == other)
+  {
+    return FALSE;
+  }
+  if (parent[root] > parent[other])
+  {
+    swap = root;
+    root = other;
+    other = swap;
+  }
+  parent[root] += parent[other];
+  parent[other] = root;
+  return TRUE;
+}
+/******************************************************************************
+*******************************************************************************
 ** FUNCTION NAME: stats_LogBaseStats
 ** PURPOSE:       
 ** AUTHOR:        Keith Clarke
@@ -3385,8 +4195,40 @@ static void
   stats_WriteControlStats (char *filename)
 {
   char func[] = "stats_WriteControlStats";
+  double reals[19];
+  int run;
   FILE *fp;
 
+  if (scen_GetWriteResultsStoreFlag ())
+  {
+    run = proc_GetCurrentRun ();
+    reals[0] = aggregate.product;
+    reals[1] = aggregate.compare;
+    reals[2] = regression.pop;
+    reals[3] = regression.edges;
+    reals[4] = regression.clusters;
+    reals[5] = regression.mean_cluster_size;
+    reals[6] = aggregate.leesalee;
+    reals[7] = regression.average_slope;
+    reals[8] = regression.percent_urban;
+    reals[9] = regression.xmean;
+    reals[10] = regression.ymean;
+    reals[11] = regression.rad;
+    reals[12] = aggregate.fmatch;
+    reals[13] = (float) (aggregate.compare * regression.edges *
+                         regression.clusters * regression.average_slope *
+                         regression.xmean * regression.ymean);
+    reals[14] = coeff_GetSavedDiffusion ();
+    reals[15] = coeff_GetSavedBreed ();
+    reals[16] = coeff_GetSavedSpread ();
+    reals[17] = coeff_GetSavedSlopeResist ();
+    reals[18] = coeff_GetSavedRoadGravity ();
+    rstore_AppendRow (rstore_DefineTable ("control_stats", 20,
+                                          control_stats_names, 1),
+                      &run, reals);
+    return;
+  }
+
   FILE_OPEN (fp, filename, "a");
 
   stats_LogControlStats (fp);
@@ -3414,6 +4256,30 @@ void
 }
 /******************************************************************************
 *******************************************************************************
+** FUNCTION NAME: stats_AddUrbanizationAttempts
+** PURPOSE:       add a batch of urbanization attempt counts
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   used by the tiled spread, whose tiles count their
+**                attempts privately.
+**
+*/
+void
+  stats_AddUrbanizationAttempts (long successes,
+                                 long z_failure,
+                                 long delta_failure,
+                                 long slope_failure,
+                                 long excluded_failure)
+{
+  urbanization_attempt.successes += successes;
+  urbanization_attempt.z_failure += z_failure;
+  urbanization_attempt.delta_failure += delta_failure;
+  urbanization_attempt.slope_failure += slope_failure;
+  urbanization_attempt.excluded_failure += excluded_failure;
+}
+/******************************************************************************
+*******************************************************************************
 ** FUNCTION NAME: stats_LogUrbanizationAttempts
 ** PURPOSE:       
 ** AUTHOR:        Keith Clarke
@@ -71,6 +71,7 @@ void stats_Dump(char* file, int line);
 void stats_Init();
 void stats_Analysis(double fmatch);
 void stats_Update(int num_growth_pix);
+void stats_FlushEnsemble();
 void stats_SetSNG(int val) ;
 void stats_SetSDG(int val) ;
 void stats_SetOG(int val) ;
@@ -112,6 +113,7 @@ double stats_GetRad() ;
 double stats_GetAvgSlope() ;
 double stats_GetMeanClusterSize() ;
 void stats_InitUrbanizationAttempts();
+void stats_InitClusters();
 void stats_LogUrbanizationAttempts(FILE* fp);
 void stats_IncrementUrbanSuccess();
 void stats_IncrementZFailure();
@@ -119,5 +121,8 @@ void stats_IncrementDeltaFailure();
 void stats_IncrementSlopeFailure();
 void stats_CreateControlFile (char *filename);
 void stats_IncrementEcludedFailure();
+void stats_AddUrbanizationAttempts (long successes, long z_failure,
+                                    long delta_failure, long slope_failure,
+                                    long excluded_failure);
 void stats_CreateStatsValFile (char *filename);
 #endif
@@ -173,14 +173,21 @@ static void
 
   char func[] = "trans_transition";
   int i;
-  int j;
   int k;
   int l;
   int lsum;
-  PIXEL land1_val;
-  PIXEL land2_val;
+  int land1_val;
+  int land2_val;
   int land1_idx;
   int land2_idx;
+  int total_pixels;
+  int count;
+  int land2_count;
+  int *pair_count;
+  int *local_pairs;
+  double *value_slope;
+  double *local_slope;
+  BOOLEAN failed;
 
 
   FUNC_INIT;
@@ -214,31 +221,95 @@ static void
     class_slope[k] = 0.0;
   }
 
-  for (i = 0; i < igrid_GetNumRows (); i++)
+  /*
+   *
+   * COUNT THE PAIRS OF PIXEL VALUES (land1, land2) AND SUM THE SLOPE OF
+   * EACH land2 VALUE, ONE PASS SHARED AMONG THE OPENMP THREADS
+   *
+   */
+  total_pixels = igrid_GetNumRows () * igrid_GetNumCols ();
+  pair_count = calloc (256 * 256, sizeof (int));
+  value_slope = calloc (256, sizeof (double));
+  failed = (pair_count == NULL) || (value_slope == NULL);
+  if (!failed)
   {
-    for (j = 0; j < igrid_GetNumCols (); j++)
+#pragma omp parallel private(i, local_pairs, local_slope)
     {
-      land1_val = land1[OFFSET (i, j)];
-      land2_val = land2[OFFSET (i, j)];
+      local_pairs = calloc (256 * 256, sizeof (int));
+      local_slope = calloc (256, sizeof (double));
+      if ((local_pairs == NULL) || (local_slope == NULL))
+      {
+        failed = TRUE;
+      }
+#pragma omp for
+      for (i = 0; i < total_pixels; i++)
+      {
+        if ((local_pairs != NULL) && (local_slope != NULL))
+        {
+          local_pairs[(land1[i] << 8) | land2[i]]++;
+          local_slope[land2[i]] += (double) slope[i];
+        }
+      }
+      if ((local_pairs != NULL) && (local_slope != NULL))
+      {
+#pragma omp critical
+        {
+          for (i = 0; i < 256 * 256; i++)
+          {
+            pair_count[i] += local_pairs[i];
+          }
+          for (i = 0; i < 256; i++)
+          {
+            value_slope[i] += local_slope[i];
+          }
+        }
+      }
+      free (local_pairs);
+      free (local_slope);
+    }
+  }
+  if (failed)
+  {
+    sprintf (msg_buf, "Unable to allocate the transition counts");
+    LOG_ERROR (msg_buf);
+    EXIT (1);
+  }
 
+  /*
+   *
+   * FOLD THE PIXEL VALUES INTO THEIR CLASSES; the slope sums are whole
+   * numbers, so they add up to the same doubles in any order
+   *
+   */
+  for (land2_val = 0; land2_val < 256; land2_val++)
+  {
+    land2_count = 0;
+    for (land1_val = 0; land1_val < 256; land1_val++)
+    {
+      count = pair_count[(land1_val << 8) | land2_val];
+      if (count == 0)
+      {
+        continue;
+      }
       land1_idx = new_indices[land1_val];
       land2_idx = new_indices[land2_val];
 
-      class_count[land1_idx][0]++;
-      class_count[land2_idx][1]++;
-
-      class_slope[land2_idx] +=
-        (double) slope[OFFSET (i, j)];
-
-
-      transition[TRANS_OFFSET (land1_idx, land2_idx)]++;
-
+      class_count[land1_idx][0] += count;
+      class_count[land2_idx][1] += count;
+      transition[TRANS_OFFSET (land1_idx, land2_idx)] += count;
       if (land1_val != land2_val)
       {
-        trans_count++;
+        trans_count += count;
       }
+      land2_count += count;
+    }
+    if (land2_count > 0)
+    {
+      class_slope[new_indices[land2_val]] += value_slope[land2_val];
     }
   }
+  free (pair_count);
+  free (value_slope);
 
   for (k = 0; k < num_classes; k++)
   {
@@ -23,6 +23,15 @@
 #define TESTING 3
 #define PIXEL unsigned char
 #define GRID_P PIXEL*
+/* Monte Carlo counts; -DACCUM_32 when more than 65535 iterations */
+#ifdef ACCUM_32
+  #define ACCUM_TYPE unsigned int
+  #define ACCUM_MAX 2147483647
+#else
+  #define ACCUM_TYPE unsigned short
+  #define ACCUM_MAX 65535
+#endif
+#define ACCUM_P ACCUM_TYPE*
 #define BOOLEAN int
 #define MAX_FILENAME_LEN 150
 #define RED_MASK   0XFF0000
@@ -47,6 +56,7 @@
 #define HIGH 2
 #define MAX_FILENAME_LEN 150
 #define CALL_STACK_SIZE 100
+#define CALL_RING_SIZE 64
 #define MAX_PROBABILITY_COLORS 100
 #define PI M_PI
 #define BOOLEAN int
@@ -54,6 +64,7 @@
 #define CLASS_SLP_TYPE double
 #define FTRANS_TYPE double
 #define COEFF_TYPE double
+#define COORD_TYPE int
 #define BYTES_PER_PIXEL sizeof(PIXEL)
 #define CLASS_SLP_TYPE double
 #define REGION_SIZE 30
@@ -63,6 +74,10 @@
 #define MIN_NGHBR_TO_SPREAD 2
 #define MAX_URBAN_YEARS 15
 #define MAX_ROAD_YEARS 15
+#define ROAD_EXPANSION_BUCKET_SIZE 16
+#define SPREAD_TILE_SIZE 128
+#define GIF_MAX_SIDE 65535
+#define CGRID_DEFAULT_MEMORY_MB 1024
 #define MAX_LANDUSE_YEARS 2
 #define RESTART_FILE "restart_file.data"
 #define BYTES_PER_WORD sizeof(PIXEL)
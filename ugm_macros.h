@@ -2,12 +2,34 @@
 #include "scenario_obj.h"
 #include "ugm_defines.h"
 #include "globals.h"
-#ifdef MAIN_MODULE
-  char glb_call_stack[CALL_STACK_SIZE][MAX_FILENAME_LEN];
-  int glb_call_stack_index;
-#else
-  extern char glb_call_stack[CALL_STACK_SIZE][MAX_FILENAME_LEN];
-  extern int glb_call_stack_index;
+/*
+ * call stack bookkeeping done by FUNC_INIT/FUNC_END:
+ *   default           named call stack (strcpy of func on every call)
+ *   -DCALL_STACK_RING ring of the last CALL_RING_SIZE entry points,
+ *                     recorded as __FILE__/__LINE__ (no string copy)
+ *   -DCALL_STACK_OFF  nothing is recorded
+ */
+#if defined(CALL_STACK_RING)
+  typedef struct
+  {
+    const char *file;
+    int line;
+  } call_ring_entry;
+  #ifdef MAIN_MODULE
+    call_ring_entry glb_call_ring[CALL_RING_SIZE];
+    int glb_call_ring_pos;
+  #else
+    extern call_ring_entry glb_call_ring[CALL_RING_SIZE];
+    extern int glb_call_ring_pos;
+  #endif
+#elif !defined(CALL_STACK_OFF)
+  #ifdef MAIN_MODULE
+    char glb_call_stack[CALL_STACK_SIZE][MAX_FILENAME_LEN];
+    int glb_call_stack_index;
+  #else
+    extern char glb_call_stack[CALL_STACK_SIZE][MAX_FILENAME_LEN];
+    extern int glb_call_stack_index;
+  #endif
 #endif
 
 #ifdef MPI
@@ -76,6 +98,23 @@
 
 #define OFFSET(i,j)    ((i)*igrid_GetNumCols() + (j))
 
+/* grid_view counterparts of OFFSET, IMAGE_PT and INTERIOR_PT */
+#define GV_OFFSET(v,i,j)    ((i)*(v)->stride + (j))
+
+#define GV_PIXEL(v,i,j)     ((v)->ptr[GV_OFFSET((v),(i),(j))])
+
+#define GV_IMAGE_PT(v,row,col)                                            \
+        (((row) <  (v)->nrows) &&                                         \
+         ((col) <  (v)->ncols) &&                                         \
+         ((row) >= 0)         &&                                          \
+         ((col) >= 0))
+
+#define GV_INTERIOR_PT(v,row,col)                                         \
+        (((row) < (v)->nrows - 1) &&                                      \
+         ((col) < (v)->ncols - 1) &&                                      \
+         ((row) > 0)             &&                                       \
+         ((col) > 0))
+
 #define IMAGE_PT(row,col)                                                 \
         (((row) <  igrid_GetNumRows()) &&                                 \
          ((col) <  igrid_GetNumCols()) &&                                 \
@@ -94,6 +133,43 @@
         (RANDOM_FLOAT < swght[slp[OFFSET ((row),(col))]]) &&              \
         (excld[OFFSET ((row),(col))] < RANDOM_INT (100))
 
+#if defined(CALL_STACK_RING)
+
+#define FUNC_INIT                                                         \
+        CALL_TRACE;                                                       \
+        glb_call_ring_pos = (glb_call_ring_pos + 1) & (CALL_RING_SIZE - 1);\
+        glb_call_ring[glb_call_ring_pos].file = __FILE__;                 \
+        glb_call_ring[glb_call_ring_pos].line = __LINE__
+
+#define FUNC_END                                                          \
+        RETURN_TRACE
+
+#define PRINT_CALL_STACK                                                  \
+        printf ("Most recent function entries:\n");                       \
+        for (glb_i = 0; glb_i < CALL_RING_SIZE; glb_i++)                  \
+        {                                                                 \
+          call_ring_entry *e_;                                            \
+          e_ = &glb_call_ring[(glb_call_ring_pos - glb_i) &               \
+                              (CALL_RING_SIZE - 1)];                      \
+          if (e_->file != NULL)                                           \
+          {                                                               \
+            printf ("  %s:%d\n", e_->file, e_->line);                     \
+          }                                                               \
+        }
+
+#elif defined(CALL_STACK_OFF)
+
+#define FUNC_INIT                                                         \
+        CALL_TRACE
+
+#define FUNC_END                                                          \
+        RETURN_TRACE
+
+#define PRINT_CALL_STACK                                                  \
+        printf ("Call stack not recorded (built with CALL_STACK_OFF)\n")
+
+#else
+
 #define FUNC_INIT                                                         \
         CALL_TRACE;                                                       \
         glb_call_stack_index++;                                           \
@@ -117,6 +193,16 @@
         }                                                                 \
         RETURN_TRACE
 
+#define PRINT_CALL_STACK                                                  \
+        printf ("Currently executing function: %s\n",                     \
+                glb_call_stack[glb_call_stack_index]);                    \
+        for (glb_i = glb_call_stack_index; glb_i >= 0; glb_i--)           \
+        {                                                                 \
+          printf ("glb_call_stack[%d]= %s\n", glb_i, glb_call_stack[glb_i]);\
+        }
+
+#endif
+
 #define ROUND_BYTES_TO_WORD_BNDRY(bytes) (((bytes)+(BYTES_PER_WORD)-1)/   \
          (BYTES_PER_WORD))*(BYTES_PER_WORD)
 
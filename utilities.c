@@ -196,21 +196,10 @@ int
                          GRID_P ptr2)                      /* IN     */
 {
   char func[] = "util_image_intersection";
-  int i;
-  int count = 0;
+  int count;
 
   FUNC_INIT;
-  assert (num_pixels > 0);
-  assert (ptr1 != NULL);
-  assert (ptr2 != NULL);
-
-  for (i = 0; i < num_pixels; i++)
-  {
-    if (ptr1[i] == ptr2[i])
-    {
-      count++;
-    }
-  }
+  util_compare_grids (num_pixels, ptr1, ptr2, NULL, NULL, &count);
   FUNC_END;
   return count;
 }
@@ -490,7 +479,7 @@ void
 **
 */
 int
-  util_count_neighbors (GRID_P grid,                         /* IN     */
+  util_count_neighbors (grid_view * grid,                    /* IN     */
                         int i,                               /* IN     */
                         int j,                               /* IN     */
                         int option,                          /* IN     */
@@ -498,77 +487,85 @@ int
 {
   char func[] = "util_count_neighbors";
   int count = 0;
+  GRID_P up;
+  GRID_P mid;
+  GRID_P down;
 
   FUNC_INIT;
   assert (grid != NULL);
+  assert (grid->ptr != NULL);
+
+  mid = grid->ptr + GV_OFFSET (grid, i, j);
+  up = mid - grid->stride;
+  down = mid + grid->stride;
 
   switch (option)
   {
   case LT:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] < value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] < value) ? 1 : 0);
+      ((up[-1] < value) ? 1 : 0) +
+      ((up[0] < value) ? 1 : 0) +
+      ((up[1] < value) ? 1 : 0) +
+      ((mid[-1] < value) ? 1 : 0) +
+      ((mid[1] < value) ? 1 : 0) +
+      ((down[-1] < value) ? 1 : 0) +
+      ((down[0] < value) ? 1 : 0) +
+      ((down[1] < value) ? 1 : 0);
     break;
   case LE:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] <= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] <= value) ? 1 : 0);
+      ((up[-1] <= value) ? 1 : 0) +
+      ((up[0] <= value) ? 1 : 0) +
+      ((up[1] <= value) ? 1 : 0) +
+      ((mid[-1] <= value) ? 1 : 0) +
+      ((mid[1] <= value) ? 1 : 0) +
+      ((down[-1] <= value) ? 1 : 0) +
+      ((down[0] <= value) ? 1 : 0) +
+      ((down[1] <= value) ? 1 : 0);
     break;
   case EQ:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] == value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] == value) ? 1 : 0);
+      ((up[-1] == value) ? 1 : 0) +
+      ((up[0] == value) ? 1 : 0) +
+      ((up[1] == value) ? 1 : 0) +
+      ((mid[-1] == value) ? 1 : 0) +
+      ((mid[1] == value) ? 1 : 0) +
+      ((down[-1] == value) ? 1 : 0) +
+      ((down[0] == value) ? 1 : 0) +
+      ((down[1] == value) ? 1 : 0);
     break;
   case NE:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] != value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] != value) ? 1 : 0);
+      ((up[-1] != value) ? 1 : 0) +
+      ((up[0] != value) ? 1 : 0) +
+      ((up[1] != value) ? 1 : 0) +
+      ((mid[-1] != value) ? 1 : 0) +
+      ((mid[1] != value) ? 1 : 0) +
+      ((down[-1] != value) ? 1 : 0) +
+      ((down[0] != value) ? 1 : 0) +
+      ((down[1] != value) ? 1 : 0);
     break;
   case GE:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] >= value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] >= value) ? 1 : 0);
+      ((up[-1] >= value) ? 1 : 0) +
+      ((up[0] >= value) ? 1 : 0) +
+      ((up[1] >= value) ? 1 : 0) +
+      ((mid[-1] >= value) ? 1 : 0) +
+      ((mid[1] >= value) ? 1 : 0) +
+      ((down[-1] >= value) ? 1 : 0) +
+      ((down[0] >= value) ? 1 : 0) +
+      ((down[1] >= value) ? 1 : 0);
     break;
   case GT:
     count =
-      ((grid[OFFSET (i - 1, j - 1)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i - 1, j + 1)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i, j - 1)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i, j + 1)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j - 1)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j)] > value) ? 1 : 0) +
-      ((grid[OFFSET (i + 1, j + 1)] > value) ? 1 : 0);
+      ((up[-1] > value) ? 1 : 0) +
+      ((up[0] > value) ? 1 : 0) +
+      ((up[1] > value) ? 1 : 0) +
+      ((mid[-1] > value) ? 1 : 0) +
+      ((mid[1] > value) ? 1 : 0) +
+      ((down[-1] > value) ? 1 : 0) +
+      ((down[0] > value) ? 1 : 0) +
+      ((down[1] > value) ? 1 : 0);
     break;
   default:
     sprintf (msg_buf, "Unknown option = %d", option);
@@ -1018,3 +1015,133 @@ void
 
   FUNC_END;
 }
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: util_init_accum
+** PURPOSE:       clear a Monte Carlo accumulator grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:
+**
+**
+*/
+void
+  util_init_accum (ACCUM_P accum)                          /* OUT    */
+{
+  assert (accum != NULL);
+  memset (accum, 0, mem_GetTotalPixels () * sizeof (ACCUM_TYPE));
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: util_accumulate_positive
+** PURPOSE:       count one more hit where grid is > 0
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   Written without a branch so that the loop vectorizes.
+**
+**
+*/
+void
+  util_accumulate_positive (GRID_P grid,                     /* IN     */
+                            ACCUM_P accum)                 /* IN/OUT */
+{
+  int i;
+  int total_pixels;
+
+  total_pixels = mem_GetTotalPixels ();
+  assert (grid != NULL);
+  assert (accum != NULL);
+
+  for (i = 0; i < total_pixels; i++)
+  {
+    accum[i] += (grid[i] > 0);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: util_normalize_accum
+** PURPOSE:       scale an accumulator into an 8 bit grid
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   out = scale * accum / divisor, in integer arithmetic.
+**
+**
+*/
+void
+  util_normalize_accum (ACCUM_P accum,                       /* IN     */
+                        int scale,                           /* IN     */
+                        int divisor,                         /* IN     */
+                        GRID_P out)                        /* OUT    */
+{
+  int i;
+  int total_pixels;
+
+  total_pixels = mem_GetTotalPixels ();
+  assert (accum != NULL);
+  assert (out != NULL);
+  assert (divisor > 0);
+
+  for (i = 0; i < total_pixels; i++)
+  {
+    out[i] = (PIXEL) (((long long) scale * accum[i]) / divisor);
+  }
+}
+
+/******************************************************************************
+*******************************************************************************
+** FUNCTION NAME: util_compare_grids
+** PURPOSE:       count the pixels set in both, set in either and equal
+** AUTHOR:        agent
+** PROGRAMMER:    agent
+** CREATION DATE: 10/19/2026
+** DESCRIPTION:   One pass serves the Lee-Sallee counts (a pixel is set
+**                when it is != 0) and the fmatch count of equal pixels.
+**                Written without a branch so that the loop vectorizes; a
+**                NULL count is not returned.
+*/
+void
+  util_compare_grids (int num_pixels,                        /* IN     */
+                      GRID_P ptr1,                           /* IN     */
+                      GRID_P ptr2,                           /* IN     */
+                      int *intersection,                     /* OUT    */
+                      int *the_union,                        /* OUT    */
+                      int *equal)                          /* OUT    */
+{
+  int i;
+  int both;
+  int either;
+  int same;
+
+  assert (num_pixels > 0);
+  assert (ptr1 != NULL);
+  assert (ptr2 != NULL);
+
+  both = 0;
+  either = 0;
+  same = 0;
+  for (i = 0; i < num_pixels; i++)
+  {
+    both += (ptr1[i] != 0) & (ptr2[i] != 0);
+    either += (ptr1[i] | ptr2[i]) != 0;
+    same += (ptr1[i] == ptr2[i]);
+  }
+
+  if (intersection != NULL)
+  {
+    *intersection = both;
+  }
+  if (the_union != NULL)
+  {
+    *the_union = either;
+  }
+  if (equal != NULL)
+  {
+    *equal = same;
+  }
+}
@@ -48,7 +48,7 @@ void util_get_neighbor(int i_in,      /* IN     */
 int
   util_trim (char s[]);   /* IN/OUT */
 
-int util_count_neighbors(GRID_P grid,   /* IN     */
+int util_count_neighbors(grid_view* grid, /* IN     */
                          int i,          /* IN     */
                          int j,          /* IN     */
                          int option,     /* IN     */
@@ -90,4 +90,25 @@ void
 util_output_gif_grid(GRID_P ptr,		/* IN     */
 	char *path				/* IN     */
 );
+
+void
+  util_init_accum (ACCUM_P accum);                         /* OUT    */
+
+void
+  util_accumulate_positive (GRID_P grid,                     /* IN     */
+                            ACCUM_P accum);                /* IN/OUT */
+
+void
+  util_normalize_accum (ACCUM_P accum,                       /* IN     */
+                        int scale,                           /* IN     */
+                        int divisor,                         /* IN     */
+                        GRID_P out);                       /* OUT    */
+
+void
+  util_compare_grids (int num_pixels,                        /* IN     */
+                      GRID_P ptr1,                           /* IN     */
+                      GRID_P ptr2,                           /* IN     */
+                      int *intersection,                     /* OUT    */
+                      int *the_union,                        /* OUT    */
+                      int *equal);                         /* OUT    */
 #endif